@@ -0,0 +1,319 @@
+// ishap_bench.cpp — runner overhead and pacing accuracy benchmarks
+// SPDX-License-Identifier: MIT
+//
+// Build with -DISHAP_BUILD_BENCHMARKS=ON, then run
+//   ishap_bench [--iterations N] [--max-substeps N] [--pacing-steps N]
+//               [--hz HZ] [--load THREADS] [--spin-us US]
+//
+// Without a build type the benchmark is configured as Release; the build
+// type is printed first, so numbers from a Debug build stand out.
+//
+// Micro benchmarks report the best of several repetitions in ns per call.
+// The pacing benchmark drives a runner with wait_for_next_step() and
+// reports how late each step started relative to its deadline, once with
+// the configured spin slice and once sleeping only, while --load threads
+// keep the remaining cores busy. The interpolation benchmark blends SoA
+// transforms with the scalar kernels and with the compiled SIMD backend.
+//
+#include <ishap/clock.hpp>
+#include <ishap/interpolate.hpp>
+#include <ishap/ishap.hpp>
+#include <ishap/static_runner.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef ISHAP_BENCH_BUILD_TYPE
+#define ISHAP_BENCH_BUILD_TYPE ""      // set by bench/CMakeLists.txt
+#endif
+
+namespace {
+
+using namespace ishap::timestep;
+using clock_type = std::chrono::steady_clock;
+
+/// @brief Side effect the optimizer must keep
+volatile uint64_t g_sink = 0;
+
+struct Options {
+    size_t  iterations      = 2'000'000;
+    size_t  max_substeps    = 64;
+    size_t  pacing_steps    = 2'000;
+    double  hz              = 240.0;
+    size_t  load_threads    = 0;
+    int64_t spin_us         = 1'000;
+};
+
+/**
+* @brief Runs fn `iterations` times per repetition and returns the best ns per call.
+* @param iterations Calls per repetition.
+* @param fn The operation to measure.
+*/
+template <class Fn>
+double measure_ns(size_t iterations, Fn&& fn) {
+    constexpr int k_repetitions = 5;
+    for (size_t i = 0; i < iterations / 10; ++i) fn(); // warm-up
+    double best = 1e300;
+    for (int r = 0; r < k_repetitions; ++r) {
+        const auto start = clock_type::now();
+        for (size_t i = 0; i < iterations; ++i) fn();
+        const std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+        best = std::min(best, elapsed.count() / static_cast<double>(iterations));
+    }
+    return best;
+}
+
+void report(const char* name, double ns_per_call, double steps_per_call = 0.0) {
+    if (steps_per_call > 0.0) {
+        std::printf("  %-44s %10.2f ns/call %10.2f ns/step\n", name, ns_per_call, ns_per_call / steps_per_call);
+    } else {
+        std::printf("  %-44s %10.2f ns/call\n", name, ns_per_call);
+    }
+}
+
+void step_fn(std::chrono::nanoseconds) { g_sink = g_sink + 1; }
+
+void bench_overhead(const Options& opt) {
+    std::printf("Runner overhead (%zu iterations)\n", opt.iterations);
+
+    {
+        FixedTimestepRunner runner{step_fn, {}};
+        report("push_time, no step due (std::function)",
+               measure_ns(opt.iterations, [&]{ (void)runner.push_time(std::chrono::nanoseconds(0)); }));
+    }
+    {
+        Config config;
+        config.step = std::chrono::hours(1);
+        FixedTimestepRunner runner{step_fn, config};
+        report("tick, no step due (std::function)",
+               measure_ns(opt.iterations, [&]{ (void)runner.tick(); }));
+    }
+    {
+        Config config;
+        config.step = std::chrono::hours(1);
+        TscClock::calibrate();
+        ClockedFixedTimestepRunner<TscClock> runner{step_fn, config};
+        report(TscClock::hardware() ? "tick, no step due (TscClock)" : "tick, no step due (TscClock fallback)",
+               measure_ns(opt.iterations, [&]{ (void)runner.tick(); }));
+    }
+    {
+        FixedTimestepRunner runner{step_fn, {}};
+        report("push_time, 1 step (std::function)",
+               measure_ns(opt.iterations, [&]{ (void)runner.push_time(k_step_60hz); }), 1.0);
+    }
+    {
+        BasicFixedTimestepRunner runner{[](std::chrono::nanoseconds) noexcept { g_sink = g_sink + 1; }};
+        report("push_time, 1 step (inlined)",
+               measure_ns(opt.iterations, [&]{ (void)runner.push_time(k_step_60hz); }), 1.0);
+    }
+    {
+        InplaceFixedTimestepRunner<> runner{step_fn, {}};
+        report("push_time, 1 step (inplace)",
+               measure_ns(opt.iterations, [&]{ (void)runner.push_time(k_step_60hz); }), 1.0);
+    }
+    {
+        auto runner = make_static_runner<k_step_60hz.count()>(
+            [](std::chrono::nanoseconds) noexcept { g_sink = g_sink + 1; });
+        report("push_time, 1 step (static)",
+               measure_ns(opt.iterations, [&]{ (void)runner.push_time(k_step_60hz); }), 1.0);
+    }
+}
+
+void bench_interpolate(const Options& opt) {
+    constexpr size_t k_transforms = 4096;
+    std::printf("Interpolation (%zu SoA transforms: position lerp + rotation nlerp)\n", k_transforms);
+
+    std::vector<float> prev(7 * k_transforms), cur(7 * k_transforms), out(7 * k_transforms);
+    for (size_t i = 0; i < k_transforms; ++i) {
+        const float angle = 0.001f * static_cast<float>(i);
+        for (size_t c = 0; c < 3; ++c) {
+            prev[c * k_transforms + i] = static_cast<float>(i + c);
+            cur[c * k_transforms + i]  = static_cast<float>(i + c) + 0.25f;
+        }
+        prev[3 * k_transforms + i] = 0.0f; prev[6 * k_transforms + i] = 1.0f;
+        cur[3 * k_transforms + i] = std::sin(angle); cur[6 * k_transforms + i] = std::cos(angle);
+    }
+    const auto at = [&](std::vector<float>& v, size_t c) { return v.data() + c * k_transforms; };
+    const ConstVec3SoA pp{at(prev, 0), at(prev, 1), at(prev, 2)}, cp{at(cur, 0), at(cur, 1), at(cur, 2)};
+    const Vec3SoA op{at(out, 0), at(out, 1), at(out, 2)};
+    const ConstQuatSoA pq{at(prev, 3), at(prev, 4), at(prev, 5), at(prev, 6)}, cq{at(cur, 3), at(cur, 4), at(cur, 5), at(cur, 6)};
+    const QuatSoA oq{at(out, 3), at(out, 4), at(out, 5), at(out, 6)};
+    const size_t iterations = std::max<size_t>(1, opt.iterations / k_transforms);
+    const double per = static_cast<double>(k_transforms);
+
+    const double scalar = measure_ns(iterations, [&]{
+        for (size_t c = 0; c < 3; ++c) detail::lerp_scalar(at(prev, c), at(cur, c), at(out, c), 0, k_transforms, 0.5f);
+        detail::nlerp_scalar(pq, cq, oq, 0, k_transforms, 0.5f);
+        g_sink = g_sink + static_cast<uint64_t>(out[0]);
+    });
+    std::printf("  %-44s %10.2f ns/call %10.2f ns/transform\n", "lerp + nlerp (scalar)", scalar, scalar / per);
+    const double simd = measure_ns(iterations, [&]{
+        lerp(pp, cp, op, k_transforms, 0.5);
+        nlerp(pq, cq, oq, k_transforms, 0.5);
+        g_sink = g_sink + static_cast<uint64_t>(out[0]);
+    });
+    const std::string name = std::string("lerp + nlerp (") + simd_backend() + ")";
+    std::printf("  %-44s %10.2f ns/call %10.2f ns/transform\n", name.c_str(), simd, simd / per);
+}
+
+template <class Runner>
+void bench_catch_up_case(const char* label, Runner& runner, size_t substeps, size_t iterations) {
+    Config config;
+    config.safety_max_substeps  = substeps;
+    config.safety_max_delta     = k_step_60hz * static_cast<std::chrono::nanoseconds::rep>(substeps + 1);
+    runner.set_max_substeps(config.safety_max_substeps);
+    runner.set_max_delta(config.safety_max_delta);
+    const auto elapsed = k_step_60hz * static_cast<std::chrono::nanoseconds::rep>(substeps);
+
+    const std::string name = std::string("catch-up ") + std::to_string(substeps) + " steps (" + label + ")";
+    const double steps = static_cast<double>(substeps);
+    report(name.c_str(), measure_ns(iterations, [&]{ (void)runner.push_time(elapsed); }), steps);
+}
+
+void bench_catch_up(const Options& opt) {
+    std::printf("Catch-up substeps\n");
+    const size_t cases[] = { size_t{1}, size_t{8}, opt.max_substeps };
+    for (size_t substeps : cases) {
+        const size_t iterations = std::max<size_t>(1, opt.iterations / substeps);
+        FixedTimestepRunner dynamic{step_fn, {}};
+        bench_catch_up_case("std::function", dynamic, substeps, iterations);
+        BasicFixedTimestepRunner inlined{[](std::chrono::nanoseconds) noexcept { g_sink = g_sink + 1; }};
+        bench_catch_up_case("inlined", inlined, substeps, iterations);
+        FixedTimestepRunner batched{step_fn, {}};
+        batched.set_batch_step_function([](size_t n, std::chrono::nanoseconds) { g_sink = g_sink + n; });
+        bench_catch_up_case("batch", batched, substeps, iterations);
+    }
+    {
+        // Rollback resimulation: rewind 8 ticks and run them again
+        constexpr size_t k_rollback_ticks = 8;
+        BasicFixedTimestepRunner runner{[](std::chrono::nanoseconds) noexcept { g_sink = g_sink + 1; }};
+        (void)runner.fast_forward(k_rollback_ticks);
+        const uint64_t now = runner.step_index();
+        report("rollback + resimulate 8 steps (inlined)",
+               measure_ns(std::max<size_t>(1, opt.iterations / k_rollback_ticks), [&]{
+                   (void)runner.rollback_to(now - k_rollback_ticks);
+                   (void)runner.resimulate(k_rollback_ticks);
+               }), static_cast<double>(k_rollback_ticks));
+    }
+}
+
+/// @brief Log-spaced histogram of step-start lateness
+class LatencyHistogram {
+public:
+    void add(std::chrono::nanoseconds late) {
+        const int64_t ns = std::max<int64_t>(0, late.count());
+        m_samples.push_back(ns);
+        size_t b = 0;
+        while (b < k_bounds.size() && ns >= k_bounds[b]) ++b;
+        ++m_counts[b];
+    }
+
+    void print(const char* title) {
+        std::printf("  %s (%zu samples)\n", title, m_samples.size());
+        if (m_samples.empty()) return;
+        for (size_t b = 0; b < m_counts.size(); ++b) {
+            if (m_counts[b] == 0) continue;
+            const bool overflow = b == k_bounds.size();
+            std::printf("    %s %8.1f us : %zu\n", overflow ? ">=" : "< ",
+                        static_cast<double>(overflow ? k_bounds.back() : k_bounds[b]) / 1e3, m_counts[b]);
+        }
+        std::sort(m_samples.begin(), m_samples.end());
+        const auto at = [&](double q) {
+            return static_cast<double>(m_samples[static_cast<size_t>(q * static_cast<double>(m_samples.size() - 1))]) / 1e3;
+        };
+        std::printf("    p50 %.1f us  p99 %.1f us  max %.1f us\n", at(0.50), at(0.99), at(1.0));
+    }
+
+private:
+    /// @brief Upper bucket bounds in ns; one extra bucket counts everything above the last bound
+    static constexpr std::array<int64_t, 13> k_bounds{
+        1'000, 2'000, 5'000, 10'000, 20'000, 50'000, 100'000, 200'000,
+        500'000, 1'000'000, 2'000'000, 5'000'000, 10'000'000
+    };
+    std::array<size_t, k_bounds.size() + 1> m_counts{};
+    std::vector<int64_t>    m_samples;
+};
+
+LatencyHistogram run_pacing(const Options& opt, std::chrono::nanoseconds spin_slice) {
+    FixedTimestepRunner runner{step_fn, {}};
+    runner.set_hz(opt.hz);
+    runner.set_wait_spin_slice(spin_slice);
+
+    LatencyHistogram histogram;
+    for (size_t i = 0; i < opt.pacing_steps; ++i) {
+        const auto deadline = runner.next_step_deadline();
+        (void)runner.wait_for_next_step();
+        histogram.add(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - deadline));
+    }
+    return histogram;
+}
+
+void bench_pacing(const Options& opt) {
+    std::printf("Pacing accuracy (%zu steps at %.1f Hz, %zu load threads)\n",
+                opt.pacing_steps, opt.hz, opt.load_threads);
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> load;
+    for (size_t i = 0; i < opt.load_threads; ++i) {
+        load.emplace_back([&stop]{
+            uint64_t x = 0;
+            while (!stop.load(std::memory_order_relaxed)) x = x * 6364136223846793005ull + 1;
+            g_sink = g_sink + x;
+        });
+    }
+
+    const auto spin = std::chrono::microseconds(opt.spin_us);
+    auto hybrid = run_pacing(opt, spin);
+    auto sleep_only = run_pacing(opt, std::chrono::nanoseconds(0));
+
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& t : load) t.join();
+
+    const std::string title = "sleep + " + std::to_string(opt.spin_us) + " us spin";
+    hybrid.print(title.c_str());
+    sleep_only.print("sleep only");
+}
+
+bool parse(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) { std::fprintf(stderr, "missing value for %s\n", arg); return false; }
+        if      (!std::strcmp(arg, "--iterations"))     opt.iterations   = std::strtoull(value, nullptr, 10);
+        else if (!std::strcmp(arg, "--max-substeps"))   opt.max_substeps = std::strtoull(value, nullptr, 10);
+        else if (!std::strcmp(arg, "--pacing-steps"))   opt.pacing_steps = std::strtoull(value, nullptr, 10);
+        else if (!std::strcmp(arg, "--hz"))             opt.hz           = std::strtod(value, nullptr);
+        else if (!std::strcmp(arg, "--load"))           opt.load_threads = std::strtoull(value, nullptr, 10);
+        else if (!std::strcmp(arg, "--spin-us"))        opt.spin_us      = std::strtoll(value, nullptr, 10);
+        else { std::fprintf(stderr, "unknown option %s\n", arg); return false; }
+        ++i;
+    }
+    opt.iterations   = std::max<size_t>(opt.iterations, 1);
+    opt.max_substeps = std::max<size_t>(opt.max_substeps, 1);
+    if (opt.hz <= 0.0) opt.hz = 240.0;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse(argc, argv, opt)) return 1;
+
+    std::printf("Build type: %s\n\n", ISHAP_BENCH_BUILD_TYPE[0] != '\0' ? ISHAP_BENCH_BUILD_TYPE : "(none)");
+    bench_overhead(opt);
+    bench_catch_up(opt);
+    bench_interpolate(opt);
+    if (opt.pacing_steps > 0) bench_pacing(opt);
+    return 0;
+}
@@ -0,0 +1,166 @@
+// adaptive_rate.hpp — opt-in step rate degradation under sustained overload
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - When the step function cannot keep up, every tick hits
+//   safety_max_substeps and the accumulator trim throws time away: the
+//   simulation runs in slow motion with no feedback
+// - AdaptiveRateController watches dropped-step pressure and, once it has
+//   lasted long enough, lengthens the step (e.g. 240 → 120 → 60 Hz)
+// - Hysteresis: degrading needs degrade_after consecutive overloaded ticks,
+//   restoring needs restore_after consecutive calm ticks, where calm also
+//   means the next faster rate would still fit the substep cap
+// - Rate changes go through the runner's set_step(), so they are recorded
+//   for replay, and are reported to an optional callback
+//
+// Usage
+//   ishap::timestep::AdaptiveRateController rate{
+//       {.base_step = ishap::timestep::k_step_240hz, .max_level = 2},
+//       [](std::chrono::nanoseconds from, std::chrono::nanoseconds to, size_t level){ /* log */ }
+//   };
+//   runner.set_rate_controller(&rate);
+//
+#pragma once
+
+#include "error_policy.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_default_rate_divisor              = 2;
+    inline constexpr size_t
+        k_default_rate_max_level            = 2;
+    inline constexpr size_t
+        k_default_rate_degrade_after        = 30;   // ticks: ~0.5s at 60 Hz
+    inline constexpr size_t
+        k_default_rate_restore_after        = 240;  // ticks: ~4s at 60 Hz
+
+	/// @brief Configuration settings for the adaptive rate controller
+struct AdaptiveRateConfig {
+	/// @brief Full-rate step duration (default: 0 = the runner's step when the controller is attached)
+    std::chrono::nanoseconds    base_step                   {0};
+	/// @brief Step multiplier per degradation level (default: 2, halving the rate)
+    size_t                      rate_divisor                = k_default_rate_divisor;
+	/// @brief Deepest degradation level; the slowest step is base_step * rate_divisor^max_level (default: 2)
+    size_t                      max_level                   = k_default_rate_max_level;
+	/// @brief Consecutive overloaded ticks before degrading one level (default: 30)
+    size_t                      degrade_after               = k_default_rate_degrade_after;
+	/// @brief Consecutive calm ticks before restoring one level (default: 240)
+    size_t                      restore_after               = k_default_rate_restore_after;
+};
+
+/**
+* @brief Lowers and restores a runner's fixed step rate based on dropped-step pressure
+* @details Attach with set_rate_controller(); the runner reports every advancing tick and applies the
+*          returned step itself. One controller per runner; not thread-safe.
+*/
+class AdaptiveRateController {
+public:
+    using OnRateChangeFunction = std::function<void(std::chrono::nanoseconds, std::chrono::nanoseconds, size_t)>;
+
+    AdaptiveRateController() = default;
+
+	/**
+	* @brief Constructs a controller with the given configuration and rate change callback.
+	* @param config The controller configuration.
+	* @param fn Called as fn(old_step, new_step, level) after every rate change.
+	*/
+    explicit AdaptiveRateController(AdaptiveRateConfig config, OnRateChangeFunction fn = {})
+        : m_config(std::move(config)), m_on_rate_change(std::move(fn)) {
+        if (m_config.rate_divisor < 2) m_config.rate_divisor = 2;
+    }
+
+	/// @brief Sets the function called as fn(old_step, new_step, level) after every rate change.
+    void set_rate_change_function(OnRateChangeFunction fn) { m_on_rate_change = std::move(fn); }
+
+	/**
+	* @brief Adopts a base step if none was configured. Called by the runner on attach.
+	* @param step The runner's current step.
+	*/
+    void bind(std::chrono::nanoseconds step) noexcept {
+        if (m_config.base_step.count() <= 0 && step.count() > 0) m_config.base_step = step;
+    }
+
+	/**
+	* @brief Feeds one advancing tick and returns the step the runner should use.
+	* @param steps Steps executed by the tick.
+	* @param dropped_steps Due steps left unexecuted by the substep cap (under CatchUpPolicy::smooth, only those
+	*        the trim discarded rather than carried to later ticks).
+	* @param trimmed Time discarded by the accumulator trim.
+	* @param max_substeps The runner's substep cap.
+	* @return The step for the current level, or zero when the level did not change.
+	*/
+    [[nodiscard]] std::chrono::nanoseconds observe(size_t steps, size_t dropped_steps,
+                                                   std::chrono::nanoseconds trimmed, size_t max_substeps) noexcept {
+        if (m_config.base_step.count() <= 0) return std::chrono::nanoseconds(0);
+
+        if (dropped_steps > 0 || trimmed.count() > 0) {
+            m_calm_ticks = 0;
+            if (++m_overloaded_ticks >= m_config.degrade_after && m_level < m_config.max_level) {
+                return change_level(m_level + 1);
+            }
+        } else {
+            m_overloaded_ticks = 0;
+            // Calm only if the faster rate (rate_divisor times the steps) would still fit the cap
+            const bool fits = steps * m_config.rate_divisor <= max_substeps;
+            m_calm_ticks = fits ? m_calm_ticks + 1 : 0;
+            if (m_level > 0 && m_calm_ticks >= m_config.restore_after) {
+                return change_level(m_level - 1);
+            }
+        }
+        return std::chrono::nanoseconds(0);
+    }
+
+	/// @brief Returns to full rate and clears the pressure counters. The runner's step is not touched.
+    void reset() noexcept { m_level = 0; m_overloaded_ticks = 0; m_calm_ticks = 0; }
+
+	/// @brief Get the current degradation level (0 = full rate).
+    [[nodiscard]] size_t level() const noexcept { return m_level; }
+	/// @brief Get the full-rate step duration.
+    [[nodiscard]] std::chrono::nanoseconds base_step() const noexcept { return m_config.base_step; }
+	/// @brief Get the step duration of the current level.
+    [[nodiscard]] std::chrono::nanoseconds current_step() const noexcept { return step_for(m_level); }
+	/// @brief Get the controller configuration.
+    [[nodiscard]] const AdaptiveRateConfig& config() const noexcept { return m_config; }
+
+private:
+    [[nodiscard]] std::chrono::nanoseconds step_for(size_t level) const noexcept {
+        std::chrono::nanoseconds s = m_config.base_step;
+        for (size_t i = 0; i < level; ++i) s *= static_cast<std::chrono::nanoseconds::rep>(m_config.rate_divisor);
+        return s;
+    }
+
+    std::chrono::nanoseconds change_level(size_t level) noexcept {
+        const std::chrono::nanoseconds from = step_for(m_level);
+        m_level = level;
+        m_overloaded_ticks = 0;
+        m_calm_ticks = 0;
+        const std::chrono::nanoseconds to = step_for(m_level);
+        if (m_on_rate_change) {
+#if ISHAP_HAS_EXCEPTIONS
+            try {
+                m_on_rate_change(from, to, m_level);
+            } catch (...) {
+                // Swallow exceptions from user code to maintain noexcept guarantee
+            }
+#else
+            m_on_rate_change(from, to, m_level);
+#endif
+        }
+        return to;
+    }
+
+private:
+    AdaptiveRateConfig              m_config{};
+    OnRateChangeFunction            m_on_rate_change{};
+    size_t                          m_level{0};
+    size_t                          m_overloaded_ticks{0};
+    size_t                          m_calm_ticks{0};
+};
+
+} // namespace ishap::timestep
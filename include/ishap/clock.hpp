@@ -0,0 +1,199 @@
+// clock.hpp — clock policies for BasicFixedTimestepRunner
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - steady_clock::now() is a syscall-free vDSO read on most hosts, but some
+//   virtualised clocksources make it cost hundreds of nanoseconds
+// - TscClock reads the CPU timestamp counter (rdtsc on x86, cntvct_el0 on
+//   AArch64) and converts with a one-off calibration against steady_clock;
+//   other targets fall back to steady_clock
+// - Ticks are converted with a fixed-point multiplier (ticks * mult >> shift,
+//   128-bit intermediate), so resolution stays at the nanosecond however
+//   long the process has been up
+// - ManualClock only moves when told to, so time-dependent behaviour can be
+//   unit-tested without sleeping; the Tag parameter gives independent clocks
+//
+// Both satisfy the std::chrono clock requirements with nanosecond durations.
+// TscClock assumes an invariant TSC (constant rate, synchronised across cores),
+// which holds on current x86 and AArch64 server parts.
+//
+// Usage
+//   ishap::timestep::TscClock::calibrate();   // optional: pay calibration up front
+//   ishap::timestep::ClockedFixedTimestepRunner<ishap::timestep::TscClock> runner{step};
+//
+//   using Clock = ishap::timestep::ManualClock;
+//   ishap::timestep::ClockedFixedTimestepRunner<Clock> test_runner{step};
+//   Clock::advance(16ms);
+//   (void)test_runner.tick();
+//
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define ISHAP_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define ISHAP_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define ISHAP_HAS_TSC 1
+#else
+#define ISHAP_HAS_TSC 0
+#endif
+
+namespace ishap::timestep {
+
+    inline constexpr std::chrono::nanoseconds
+        k_tsc_calibration_window            { 10'000'000 }; // 10ms
+
+/**
+* @brief Low-overhead steady clock backed by the CPU timestamp counter
+* @details The first now() (or calibrate()) busy-waits k_tsc_calibration_window to measure the counter
+*          rate against steady_clock. The epoch matches steady_clock's at calibration time.
+*/
+struct TscClock {
+    using rep                           = std::chrono::nanoseconds::rep;
+    using period                        = std::chrono::nanoseconds::period;
+    using duration                      = std::chrono::nanoseconds;
+    using time_point                    = std::chrono::time_point<TscClock>;
+    static constexpr bool is_steady     = true;
+
+	/// @brief Returns whether a hardware counter is used (false: steady_clock fallback).
+    [[nodiscard]] static constexpr bool hardware() noexcept { return ISHAP_HAS_TSC != 0; }
+
+	/// @brief Reads the clock.
+    [[nodiscard]] static time_point now() noexcept {
+#if ISHAP_HAS_TSC
+        const Calibration& c = calibration();
+        // Signed: a core whose counter trails the calibrating core reads slightly before base_ticks
+        const auto ticks = static_cast<int64_t>(read_counter() - c.base_ticks);
+        const rep ns = ticks >= 0 ?  static_cast<rep>(scale(static_cast<uint64_t>(ticks), c.mult, c.shift))
+                                  : -static_cast<rep>(scale(uint64_t{0} - static_cast<uint64_t>(ticks), c.mult, c.shift));
+        return time_point(duration(c.base_ns + ns));
+#else
+        return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+#endif
+    }
+
+	/// @brief Forces calibration now instead of on the first now().
+    static void calibrate() noexcept {
+#if ISHAP_HAS_TSC
+        (void)calibration();
+#endif
+    }
+
+	/// @brief Get the calibrated counter period in nanoseconds per tick (1.0 for the fallback).
+    [[nodiscard]] static double ns_per_tick() noexcept {
+#if ISHAP_HAS_TSC
+        return calibration().ns_per_tick;
+#else
+        return 1.0;
+#endif
+    }
+
+#if ISHAP_HAS_TSC
+	/// @brief Reads the raw hardware counter.
+    [[nodiscard]] static uint64_t read_counter() noexcept {
+#if defined(__aarch64__) && !defined(_MSC_VER)
+        uint64_t v;
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#else
+        return static_cast<uint64_t>(__rdtsc());
+#endif
+    }
+
+private:
+    struct Calibration {
+        uint64_t    base_ticks;
+        rep         base_ns;
+        double      ns_per_tick;
+		/// @brief Nanoseconds per tick as mult / 2^shift
+        uint64_t    mult;
+        unsigned    shift;
+    };
+
+	/// @brief Returns (ticks * mult) >> shift without overflowing the intermediate product.
+    [[nodiscard]] static uint64_t scale(uint64_t ticks, uint64_t mult, unsigned shift) noexcept {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 u128;     // __extension__ keeps -Wpedantic quiet
+        return static_cast<uint64_t>((static_cast<u128>(ticks) * mult) >> shift);
+#else
+        // 64 x 64 -> 128 bit product from 32-bit limbs
+        const uint64_t a_lo = ticks & 0xffffffffu, a_hi = ticks >> 32;
+        const uint64_t b_lo = mult & 0xffffffffu,  b_hi = mult >> 32;
+        const uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+        const uint64_t mid = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + (lo_hi & 0xffffffffu);
+        const uint64_t lo = (mid << 32) | (lo_lo & 0xffffffffu);
+        const uint64_t hi = hi_hi + (hi_lo >> 32) + (lo_hi >> 32) + (mid >> 32);
+        if (shift == 0) return lo;
+        return (hi << (64 - shift)) | (lo >> shift);
+#endif
+    }
+
+    static const Calibration& calibration() noexcept {
+        static const Calibration c = measure();
+        return c;
+    }
+
+    static Calibration measure() noexcept {
+        using sc = std::chrono::steady_clock;
+        const auto t0 = sc::now();
+        const uint64_t c0 = read_counter();
+        auto t1 = t0;
+        while ((t1 = sc::now()) - t0 < k_tsc_calibration_window) {}
+        const uint64_t c1 = read_counter();
+        const double ns = static_cast<double>(std::chrono::duration_cast<duration>(t1 - t0).count());
+        const double ticks = static_cast<double>(c1 - c0);
+        Calibration c;
+        c.base_ticks    = c1;
+        c.base_ns       = std::chrono::duration_cast<duration>(t1.time_since_epoch()).count();
+        c.ns_per_tick   = ticks > 0.0 ? ns / ticks : 1.0;
+        // Largest shift that keeps mult below 2^62: about 62 significant bits for any counter rate
+        c.shift = 62;
+        while (c.shift > 0 && std::ldexp(c.ns_per_tick, static_cast<int>(c.shift)) >= 0x1p62) --c.shift;
+        c.mult = static_cast<uint64_t>(std::llround(std::ldexp(c.ns_per_tick, static_cast<int>(c.shift))));
+        return c;
+    }
+#endif
+};
+
+/**
+* @brief Steady clock that only advances when told to, for tests
+* @tparam Tag Distinguishes independent clocks; each instantiation has its own time.
+* @details Starts at its epoch. Advancing is atomic, so a test thread may drive it while another ticks.
+*          wait_for_next_step() / run_until() return only once another thread has advanced the clock past
+*          the step deadline: they sleep the remaining clock time in real time, then spin on now(). On a
+*          single thread, drive the runner with tick() / push_time() instead.
+*/
+template <class Tag = void>
+struct BasicManualClock {
+    using rep                           = std::chrono::nanoseconds::rep;
+    using period                        = std::chrono::nanoseconds::period;
+    using duration                      = std::chrono::nanoseconds;
+    using time_point                    = std::chrono::time_point<BasicManualClock>;
+    static constexpr bool is_steady     = true;
+
+	/// @brief Reads the clock.
+    [[nodiscard]] static time_point now() noexcept {
+        return time_point(duration(s_now.load(std::memory_order_acquire)));
+    }
+	/// @brief Moves the clock forward. Negative durations are ignored to keep it steady.
+    static void advance(duration d) noexcept {
+        if (d.count() > 0) s_now.fetch_add(d.count(), std::memory_order_acq_rel);
+    }
+	/// @brief Sets the clock back to its epoch, for test setup.
+    static void reset() noexcept { s_now.store(0, std::memory_order_release); }
+
+private:
+    inline static std::atomic<rep>      s_now{0};
+};
+
+/// @brief The default manual clock
+using ManualClock = BasicManualClock<>;
+
+} // namespace ishap::timestep
@@ -0,0 +1,138 @@
+// control_channel.hpp — non-blocking control plane for changing a runner from other threads
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - set_time_scale(), pause() and set_hz() write the runner's config while
+//   the sim thread reads it; calling them from a console or ops thread is a
+//   data race, and a mutex around every tick() costs each frame
+// - ControlChannel keeps one pending ControlUpdate behind a tiny spin lock:
+//   posting merges the update into it under the lock (any number of threads
+//   may post; they only contend with each other for a few stores)
+// - The runner only ever try-locks: at the start of the next tick() /
+//   push_time() it takes the whole pending update and applies it through
+//   its regular setters, so an attached recorder logs them; if a post is in
+//   progress it leaves everything for the next tick instead of waiting. With
+//   nothing pending the hot path costs a relaxed load
+// - Settings posted together in one ControlUpdate are applied in the same
+//   tick (a post is never split across ticks); the latest posted value of
+//   each setting wins
+//
+// Usage
+//   ishap::timestep::ControlChannel control;
+//   runner.set_control_channel(&control);
+//   // any thread
+//   control.set_time_scale(0.5);
+//   control.post({.paused = true, .time_scale = 1.0});
+//
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+
+namespace ishap::timestep {
+
+/// @brief Settings to change together; unset members are left alone
+struct ControlUpdate {
+	/// @brief Pause (true) or resume (false)
+    std::optional<bool>                         paused{};
+	/// @brief Time scale; negative values are clamped to 0 by the runner
+    std::optional<double>                       time_scale{};
+	/// @brief Fixed step; non-positive values are ignored by the runner
+    std::optional<std::chrono::nanoseconds>     step{};
+	/// @brief Safety max delta; non-positive values are ignored by the runner
+    std::optional<std::chrono::nanoseconds>     max_delta{};
+	/// @brief Substep cap; 0 is treated as 1 by the runner
+    std::optional<size_t>                       max_substeps{};
+};
+
+/**
+* @brief Multi-producer, single-consumer channel of pending runner settings
+* @details Post from any thread; attach to exactly one runner with set_control_channel(), which applies
+*          the pending settings on the thread that ticks it.
+*/
+class ControlChannel {
+public:
+    enum : uint32_t {
+        k_dirty_paused          = 1u << 0,
+        k_dirty_time_scale      = 1u << 1,
+        k_dirty_step            = 1u << 2,
+        k_dirty_max_delta       = 1u << 3,
+        k_dirty_max_substeps    = 1u << 4,
+    };
+
+    ControlChannel() = default;
+    ControlChannel(const ControlChannel&)            = delete;
+    ControlChannel& operator=(const ControlChannel&) = delete;
+
+	/// @brief Posts several settings to be applied in the same tick. Any thread.
+    void post(const ControlUpdate& u) noexcept {
+        if (!u.paused && !u.time_scale && !u.step && !u.max_delta && !u.max_substeps) return;
+        while (m_lock.exchange(true, std::memory_order_acquire)) std::this_thread::yield();
+        if (u.paused)       m_pending.paused        = u.paused;
+        if (u.time_scale)   m_pending.time_scale    = u.time_scale;
+        if (u.step)         m_pending.step          = u.step;
+        if (u.max_delta)    m_pending.max_delta     = u.max_delta;
+        if (u.max_substeps) m_pending.max_substeps  = u.max_substeps;
+        m_has_pending.store(true, std::memory_order_relaxed);
+        m_lock.store(false, std::memory_order_release);
+    }
+
+	/// @brief Posts a pause (true) or resume (false). Any thread.
+    void pause(bool p = true) noexcept { ControlUpdate u; u.paused = p; post(u); }
+	/// @brief Posts a resume. Any thread.
+    void resume() noexcept { pause(false); }
+	/// @brief Posts a time scale. Any thread.
+    void set_time_scale(double s) noexcept { ControlUpdate u; u.time_scale = s; post(u); }
+	/// @brief Posts a fixed step. Any thread.
+    void set_step(std::chrono::nanoseconds s) noexcept { ControlUpdate u; u.step = s; post(u); }
+	/// @brief Posts a fixed update rate in Hertz; non-positive rates are ignored. Any thread.
+    void set_hz(double hz) noexcept {
+        if (hz <= 0.0) return;
+        set_step(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / hz)));
+    }
+	/// @brief Posts a safety max delta. Any thread.
+    void set_max_delta(std::chrono::nanoseconds d) noexcept { ControlUpdate u; u.max_delta = d; post(u); }
+	/// @brief Posts a substep cap. Any thread.
+    void set_max_substeps(size_t n) noexcept { ControlUpdate u; u.max_substeps = n; post(u); }
+
+	/// @brief Returns whether settings are waiting to be applied.
+    [[nodiscard]] bool pending() const noexcept { return m_has_pending.load(std::memory_order_relaxed); }
+
+	/**
+	* @brief Takes every pending setting and passes it to a runner. Called by the runner; consumer thread only.
+	* @param runner Anything with pause(), set_time_scale(), set_step(), set_max_delta() and set_max_substeps().
+	* @return The k_dirty_* mask of the settings applied (0 if nothing was pending, or a post was in progress).
+	* @details Never waits: while a producer holds the lock, everything is left for the next call.
+	*/
+    template <class Runner>
+    uint32_t apply(Runner& runner) noexcept {
+        if (!m_has_pending.load(std::memory_order_relaxed)) return 0;
+        if (m_lock.exchange(true, std::memory_order_acquire)) return 0;
+        const ControlUpdate u = m_pending;
+        m_pending = ControlUpdate{};
+        m_has_pending.store(false, std::memory_order_relaxed);
+        m_lock.store(false, std::memory_order_release);
+
+        uint32_t dirty = 0;
+        if (u.step)         { runner.set_step(*u.step);                 dirty |= k_dirty_step; }
+        if (u.max_delta)    { runner.set_max_delta(*u.max_delta);       dirty |= k_dirty_max_delta; }
+        if (u.max_substeps) { runner.set_max_substeps(*u.max_substeps); dirty |= k_dirty_max_substeps; }
+        if (u.time_scale)   { runner.set_time_scale(*u.time_scale);     dirty |= k_dirty_time_scale; }
+        if (u.paused)       { runner.pause(*u.paused);                  dirty |= k_dirty_paused; }
+        return dirty;
+    }
+
+private:
+	/// @brief Spin lock guarding m_pending; producers wait for it, the consumer only tries it
+    std::atomic<bool>               m_lock{false};
+	/// @brief Whether m_pending holds anything; read without the lock for the fast path
+    std::atomic<bool>               m_has_pending{false};
+	/// @brief Settings posted since the last apply(), merged
+    ControlUpdate                   m_pending{};
+};
+
+} // namespace ishap::timestep
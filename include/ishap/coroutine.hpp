@@ -0,0 +1,327 @@
+// coroutine.hpp — C++20 coroutines driven by the fixed step
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Scripted sequences written as per-step state machines poll their
+//   condition on every step; a suspended coroutine costs nothing until due
+// - StepScheduler is an ordinary step callable: install it as (or call it
+//   from) the runner's step function and waiting tasks resume inside the
+//   advance() step loop, in the order they suspended
+// - Coroutine frames come from a block arena preallocated by the scheduler,
+//   so spawning and resuming never touch the heap; a frame that does not fit
+//   or an exhausted arena yields an empty StepTask instead of throwing
+// - Needs C++20 (configure with ISHAP_ENABLE_COROUTINES=ON or compile the
+//   including target as cxx_std_20); the rest of the library stays C++17
+//
+// Usage
+//   ishap::timestep::StepTask open_door(ishap::timestep::StepScheduler& s, Door& door) {
+//       door.start_opening();
+//       co_await s.steps(30);                     // resumed 30 fixed steps later
+//       door.finish_opening();
+//       const auto dt = co_await s.next_step();   // and once more on the next step
+//       door.settle(dt);
+//   }
+//
+//   ishap::timestep::StepScheduler scheduler{64};  // up to 64 live tasks
+//   ishap::timestep::FixedTimestepRunner runner{[&](std::chrono::nanoseconds dt){
+//       physics.step(dt);
+//       scheduler(dt);
+//   }};
+//   scheduler.spawn(open_door(scheduler, door));
+//
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "ishap/coroutine.hpp requires C++20 coroutines (cxx_std_20, see ISHAP_ENABLE_COROUTINES)"
+#else
+
+#include "error_policy.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_default_coroutine_frame_size      = 1024; // bytes per arena block
+
+class StepScheduler;
+
+namespace detail {
+
+	/// @brief Binds to any coroutine parameter the frame allocator ignores
+    struct IgnoredCoroutineArg {
+        IgnoredCoroutineArg() noexcept = default;
+        template <class T>
+        IgnoredCoroutineArg(T&&) noexcept {}
+    };
+
+} // namespace detail
+
+/**
+* @brief Coroutine return type for step-driven tasks
+* @details The coroutine's first parameter (after the object parameter of a member or lambda coroutine) must
+*          be the StepScheduler whose arena holds its frame, followed by at most six more parameters.
+*          The task starts suspended; hand it to
+*          StepScheduler::spawn() to run it. An empty task (valid() == false) means the frame could not be
+*          allocated.
+*/
+class StepTask {
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    struct promise_type {
+        StepScheduler*                  scheduler{nullptr};
+
+        template <class... Args>
+        explicit promise_type(StepScheduler& s, Args&&...) noexcept : scheduler(&s) {}
+        template <class Self, class... Args>
+        promise_type(Self&&, StepScheduler& s, Args&&...) noexcept : scheduler(&s) {}
+
+        // Frame allocators are not templates: GCC 12 pairs a function template operator new with no usual
+        // operator delete and reports -Wmismatched-new-delete on every coroutine. Defaulted ignored
+        // parameters stand in for the pack.
+        using Arg = detail::IgnoredCoroutineArg;
+        static void* operator new(size_t size, StepScheduler& s, Arg = {}, Arg = {}, Arg = {},
+                                  Arg = {}, Arg = {}, Arg = {}) noexcept;
+        static void* operator new(size_t size, Arg self, StepScheduler& s, Arg = {}, Arg = {}, Arg = {},
+                                  Arg = {}, Arg = {}, Arg = {}) noexcept;
+        static void operator delete(void* frame, size_t size) noexcept;
+
+        static StepTask get_return_object_on_allocation_failure() noexcept { return StepTask{}; }
+        StepTask get_return_object() noexcept { return StepTask{handle_type::from_promise(*this)}; }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept;
+    };
+
+    StepTask() noexcept = default;
+    StepTask(const StepTask&)            = delete;
+    StepTask& operator=(const StepTask&) = delete;
+    StepTask(StepTask&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    StepTask& operator=(StepTask&& other) noexcept {
+        if (this != &other) { destroy(); m_handle = std::exchange(other.m_handle, nullptr); }
+        return *this;
+    }
+    ~StepTask() { destroy(); }
+
+	/// @brief Returns whether the task holds a coroutine that has not been spawned yet.
+    [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(m_handle); }
+
+private:
+    friend class StepScheduler;
+    explicit StepTask(handle_type h) noexcept : m_handle(h) {}
+    [[nodiscard]] handle_type release() noexcept { return std::exchange(m_handle, nullptr); }
+    void destroy() noexcept { if (m_handle) { m_handle.destroy(); m_handle = nullptr; } }
+
+    handle_type                         m_handle{};
+};
+
+/**
+* @brief Resumes suspended StepTasks on fixed steps and owns their frame arena
+* @details Call it once per fixed step, as (dt) from a step function or as (steps, dt) from a batch step
+*          function. Single-threaded: spawn, await and step from the thread that ticks the runner.
+*/
+class StepScheduler {
+public:
+	/// @brief Awaitable that resumes the awaiting task after a number of steps, yielding the step duration
+    class StepAwaiter {
+    public:
+        [[nodiscard]] bool await_ready() const noexcept { return m_steps == 0; }
+        void await_suspend(std::coroutine_handle<> h) const noexcept { m_scheduler->suspend(h, m_steps); }
+        [[nodiscard]] std::chrono::nanoseconds await_resume() const noexcept { return m_scheduler->m_last_step; }
+
+    private:
+        friend class StepScheduler;
+        StepAwaiter(StepScheduler& s, uint64_t steps) noexcept : m_scheduler(&s), m_steps(steps) {}
+        StepScheduler*                  m_scheduler;
+        uint64_t                        m_steps;
+    };
+
+	/**
+	* @brief Preallocates the frame arena and the wait list.
+	* @param max_tasks Maximum number of live (spawned, not yet finished) tasks.
+	* @param frame_size Largest coroutine frame, in bytes, one arena block can hold.
+	* @details If the arena cannot be allocated the scheduler has capacity 0 and every task is empty.
+	*/
+    explicit StepScheduler(size_t max_tasks, size_t frame_size = k_default_coroutine_frame_size) noexcept {
+        m_block_size = round_up(frame_size) + k_header_size;
+        m_arena.reset(new (std::nothrow) unsigned char[m_block_size * max_tasks]);
+        if (!m_arena) return;
+        m_capacity = max_tasks;
+        m_frame_capacity = m_block_size - k_header_size;
+        for (size_t i = max_tasks; i-- > 0;) {
+            unsigned char* block = m_arena.get() + i * m_block_size;
+            *reinterpret_cast<void**>(block + k_header_size) = m_free;
+            m_free = block;
+        }
+#if ISHAP_HAS_EXCEPTIONS
+        try {
+#endif
+            m_waiters.reserve(max_tasks);
+            m_ready.reserve(max_tasks);
+#if ISHAP_HAS_EXCEPTIONS
+        } catch (...) {
+            m_capacity = 0;
+            m_free = nullptr;
+        }
+#endif
+    }
+
+    StepScheduler(const StepScheduler&)            = delete;
+    StepScheduler& operator=(const StepScheduler&) = delete;
+
+	/// @brief Destroys every task that is still suspended.
+    ~StepScheduler() {
+        for (const Waiter& w : m_waiters) w.handle.destroy();
+    }
+
+	/**
+	* @brief Starts a task: it runs until its first co_await, then resumes on the steps it waits for.
+	* @param task The task, created with this scheduler as its first parameter.
+	* @return False if the task is empty (frame allocation failed).
+	*/
+    bool spawn(StepTask task) noexcept {
+        if (!task.valid()) return false;
+        task.release().resume();
+        return true;
+    }
+
+	/// @brief Awaitable resuming on the next fixed step.
+    [[nodiscard]] StepAwaiter next_step() noexcept { return StepAwaiter{*this, 1}; }
+	/// @brief Awaitable resuming after n fixed steps; zero does not suspend.
+    [[nodiscard]] StepAwaiter steps(uint64_t n) noexcept { return StepAwaiter{*this, n}; }
+
+	/**
+	* @brief Counts one fixed step and resumes every task due on it, in suspension order.
+	* @param dt The fixed step duration, returned to the resumed tasks' co_await.
+	*/
+    void operator()(std::chrono::nanoseconds dt) noexcept {
+        ++m_step_count;
+        m_last_step = dt;
+        if (m_waiters.empty() || m_step_count < m_next_wake) return;
+
+        // Move due tasks out first: resumed tasks may suspend again and append to m_waiters
+        m_ready.clear();
+        m_next_wake = UINT64_MAX;
+        size_t kept = 0;
+        for (size_t i = 0; i < m_waiters.size(); ++i) {
+            const Waiter w = m_waiters[i];
+            if (w.wake <= m_step_count) { m_ready.push_back(w.handle); continue; }
+            if (w.wake < m_next_wake) m_next_wake = w.wake;
+            m_waiters[kept++] = w;
+        }
+        m_waiters.resize(kept);
+        for (std::coroutine_handle<> h : m_ready) h.resume();
+    }
+
+	/**
+	* @brief Runs a batch of fixed steps.
+	* @param steps The number of steps.
+	* @param dt The fixed step duration.
+	*/
+    void operator()(size_t steps, std::chrono::nanoseconds dt) noexcept {
+        for (size_t i = 0; i < steps; ++i) (*this)(dt);
+    }
+
+	/// @brief Get the number of fixed steps counted so far.
+    [[nodiscard]] uint64_t step_count() const noexcept { return m_step_count; }
+	/// @brief Get the number of live tasks (frames in use).
+    [[nodiscard]] size_t live_tasks() const noexcept { return m_live; }
+	/// @brief Get the number of suspended tasks waiting for a step.
+    [[nodiscard]] size_t waiting_tasks() const noexcept { return m_waiters.size(); }
+	/// @brief Get the maximum number of live tasks.
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+	/// @brief Get the largest frame, in bytes, an arena block can hold.
+    [[nodiscard]] size_t frame_capacity() const noexcept { return m_frame_capacity; }
+	/// @brief Get the number of tasks that ended with an unhandled exception.
+    [[nodiscard]] size_t task_errors() const noexcept { return m_errors; }
+	/// @brief Get the number of frame allocations refused (frame too large or arena exhausted).
+    [[nodiscard]] size_t allocation_failures() const noexcept { return m_allocation_failures; }
+
+private:
+    friend struct StepTask::promise_type;
+
+    struct Waiter {
+        uint64_t                        wake;
+        std::coroutine_handle<>         handle;
+    };
+
+	/// @brief Block header: the owning scheduler, padded so the frame keeps max alignment
+    static constexpr size_t k_header_size = alignof(std::max_align_t) > sizeof(void*) ? alignof(std::max_align_t) : sizeof(void*);
+
+    [[nodiscard]] static constexpr size_t round_up(size_t n) noexcept {
+        const size_t a = alignof(std::max_align_t);
+        n = n < sizeof(void*) ? sizeof(void*) : n;
+        return (n + a - 1) / a * a;
+    }
+
+    void suspend(std::coroutine_handle<> h, uint64_t steps) noexcept {
+        const uint64_t wake = m_step_count + steps;
+        if (wake < m_next_wake) m_next_wake = wake;
+        m_waiters.push_back(Waiter{wake, h}); // capacity reserved for every live task
+    }
+
+    [[nodiscard]] void* allocate(size_t size) noexcept {
+        if (size > m_frame_capacity || !m_free) { ++m_allocation_failures; return nullptr; }
+        unsigned char* block = m_free;
+        m_free = static_cast<unsigned char*>(*reinterpret_cast<void**>(block + k_header_size));
+        *reinterpret_cast<StepScheduler**>(block) = this;
+        ++m_live;
+        return block + k_header_size;
+    }
+
+    static void deallocate(void* frame) noexcept {
+        unsigned char* block = static_cast<unsigned char*>(frame) - k_header_size;
+        StepScheduler* self = *reinterpret_cast<StepScheduler**>(block);
+        *reinterpret_cast<void**>(frame) = self->m_free;
+        self->m_free = block;
+        --self->m_live;
+    }
+
+private:
+	// --- Frame arena ---
+    std::unique_ptr<unsigned char[]>    m_arena{};
+    unsigned char*                      m_free{nullptr};
+    size_t                              m_block_size{0};
+    size_t                              m_frame_capacity{0};
+    size_t                              m_capacity{0};
+    size_t                              m_live{0};
+    size_t                              m_allocation_failures{0};
+
+	// --- Scheduling ---
+    std::vector<Waiter>                 m_waiters{};
+    std::vector<std::coroutine_handle<>> m_ready{};
+    uint64_t                            m_step_count{0};
+	/// @brief Earliest wake step among m_waiters, so steps with nothing due skip the scan
+    uint64_t                            m_next_wake{UINT64_MAX};
+    std::chrono::nanoseconds            m_last_step{0};
+    size_t                              m_errors{0};
+};
+
+inline void* StepTask::promise_type::operator new(size_t size, StepScheduler& s, Arg, Arg, Arg, Arg, Arg, Arg) noexcept {
+    return s.allocate(size);
+}
+
+inline void* StepTask::promise_type::operator new(size_t size, Arg, StepScheduler& s, Arg, Arg, Arg, Arg, Arg, Arg) noexcept {
+    return s.allocate(size);
+}
+
+inline void StepTask::promise_type::operator delete(void* frame, size_t) noexcept { StepScheduler::deallocate(frame); }
+
+inline void StepTask::promise_type::unhandled_exception() noexcept {
+    ++scheduler->m_errors;
+    // Swallow exceptions from user code; the task ends and its frame returns to the arena
+}
+
+} // namespace ishap::timestep
+
+#endif // __cpp_impl_coroutine
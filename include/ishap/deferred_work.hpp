@@ -0,0 +1,233 @@
+// deferred_work.hpp — step-budgeted queue for optional per-step work
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Optional work (pathfinding batches, LOD updates, cache warming) either
+//   overruns the step when done inline or never runs when skipped
+// - DeferredWorkQueue holds jobs in preallocated rings, one per priority;
+//   after a step the runner hands it the rest of the step's wall-time budget
+//   (budget_fraction * step / time_scale minus the measured step cost) and
+//   jobs run, highest priority first, until that budget is used up
+// - Jobs are cooperative: a job gets the deadline, does a slice of work and
+//   returns false to be resumed after a later step (behind the other jobs of
+//   its priority), or true when finished; each queued job gets at most one
+//   slice per run, so a job that yields early does not spin in the budget
+// - Jobs are InplaceFunction objects: captures up to
+//   k_deferred_job_capacity bytes are stored in the preallocated rings,
+//   larger ones fail to compile, and push() never allocates
+// - Only the last step of a tick is followed by deferred work, so owed
+//   catch-up steps are never delayed; fast_forward() and resimulate() run
+//   none
+// - Budgets use std::chrono::steady_clock whatever the runner's clock, so a
+//   manual clock does not turn the budget into an endless loop
+//
+// Usage
+//   ishap::timestep::DeferredWorkQueue work{256};
+//   runner.set_deferred_work(&work);
+//   work.push([&](auto deadline){ return paths.solve_until(deadline); }, ishap::timestep::WorkPriority::low);
+//
+#pragma once
+
+#include "error_policy.hpp"
+#include "inplace_function.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_default_deferred_capacity         = 256;     // jobs per priority
+    inline constexpr double
+        k_default_deferred_budget_fraction  = 0.8;
+    inline constexpr std::chrono::nanoseconds
+        k_default_deferred_min_slice        { 20'000 }; // 20us
+    inline constexpr size_t
+        k_deferred_job_capacity             = 48;      // bytes of capture storage per job
+
+/// @brief Priority of a deferred job; higher priorities run first
+enum class WorkPriority : uint8_t {
+    high        = 0,
+    normal      = 1,
+    low         = 2,
+};
+
+    inline constexpr size_t
+        k_work_priority_count               = 3;
+
+	/// @brief Configuration settings for the deferred work queue
+struct DeferredWorkConfig {
+	/// @brief Maximum queued jobs per priority (default: 256)
+    size_t                      capacity            = k_default_deferred_capacity;
+	/// @brief Fraction of a step's wall time that step plus deferred work may use (default: 0.8)
+    double                      budget_fraction     = k_default_deferred_budget_fraction;
+	/// @brief Smallest remaining budget worth starting a job in (default: 20us)
+    std::chrono::nanoseconds    min_slice           = k_default_deferred_min_slice;
+};
+
+/**
+* @brief Priority queue of cooperative jobs run in the idle headroom of fixed steps
+* @details Attach with set_deferred_work(); the runner calls run_after_step(). Jobs are pushed and run on
+*          the thread that ticks the runner; not thread-safe.
+*/
+class DeferredWorkQueue {
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+	/// @brief Job invoked as job(deadline); returns true when finished, false to be resumed later.
+	///        Stored in place: captures larger than k_deferred_job_capacity bytes fail to compile.
+    using Job = InplaceFunction<bool(time_point), k_deferred_job_capacity>;
+
+	/**
+	* @brief Constructs a queue with preallocated job rings.
+	* @param config The queue configuration. If allocation fails the queue has capacity 0 and rejects every job.
+	*/
+    explicit DeferredWorkQueue(DeferredWorkConfig config = {}) noexcept : m_config(config) {
+        if (m_config.budget_fraction < 0.0) m_config.budget_fraction = 0.0;
+        if (m_config.budget_fraction > 1.0) m_config.budget_fraction = 1.0;
+        for (auto& ring : m_rings) {
+            ring.jobs.reset(new (std::nothrow) Job[m_config.capacity]);
+            if (!ring.jobs) { for (auto& r : m_rings) r.jobs.reset(); m_config.capacity = 0; break; }
+        }
+    }
+
+	/// @brief Constructs a queue holding up to `capacity` jobs per priority.
+    explicit DeferredWorkQueue(size_t capacity) noexcept : DeferredWorkQueue(DeferredWorkConfig{capacity}) {}
+
+    DeferredWorkQueue(const DeferredWorkQueue&)            = delete;
+    DeferredWorkQueue& operator=(const DeferredWorkQueue&) = delete;
+
+	/**
+	* @brief Queues a job behind the other jobs of its priority.
+	* @param job Invoked as job(deadline) after later steps until it returns true.
+	* @param priority The job's priority.
+	* @return False if that priority's ring is full.
+	*/
+    bool push(Job job, WorkPriority priority = WorkPriority::normal) {
+        Ring& ring = m_rings[static_cast<size_t>(priority)];
+        if (ring.size >= m_config.capacity || !job) return false;
+        ring.jobs[(ring.head + ring.size) % m_config.capacity] = std::move(job);
+        ++ring.size;
+        return true;
+    }
+
+	/**
+	* @brief Runs jobs in the headroom left by a step. Called by the runner.
+	* @param step_start When the step (or batch) started.
+	* @param step_wall Wall time the step (or batch) is allotted: steps * step / time scale.
+	* @return The number of job slices run.
+	*/
+    size_t run_after_step(time_point step_start, std::chrono::nanoseconds step_wall) noexcept {
+        const auto budget = std::chrono::duration_cast<std::chrono::nanoseconds>(step_wall * m_config.budget_fraction);
+        return run_until(step_start + budget);
+    }
+
+	/**
+	* @brief Runs jobs for a given budget from now.
+	* @return The number of job slices run.
+	*/
+    size_t run(std::chrono::nanoseconds budget) noexcept { return run_until(clock_type::now() + budget); }
+
+	/**
+	* @brief Runs jobs, highest priority first, while at least min_slice remains before the deadline.
+	* @details Each job queued at the start of the run gets at most one slice; one that returns false goes
+	*          behind its priority's other jobs and waits for a later run.
+	* @param deadline Time by which the last job slice should return.
+	* @return The number of job slices run.
+	*/
+    size_t run_until(time_point deadline) noexcept {
+        time_point now = clock_type::now();
+        m_last_budget = deadline > now ? std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now)
+                                       : std::chrono::nanoseconds(0);
+        const time_point start = now;
+        size_t run = 0;
+        for (Ring& ring : m_rings) {
+            // One slice per queued job, in FIFO order; lower priorities get what is left of the budget
+            for (size_t pending = ring.size; pending > 0 && deadline - now >= m_config.min_slice; --pending) {
+                Job job = std::move(ring.jobs[ring.head]);
+                ring.head = (ring.head + 1) % m_config.capacity;
+                --ring.size;
+                if (!call(job, deadline)) {
+                    ring.jobs[(ring.head + ring.size) % m_config.capacity] = std::move(job);
+                    ++ring.size;
+                } else {
+                    ++m_completed;
+                }
+                ++run;
+                now = clock_type::now();
+                if (now > deadline) ++m_overruns;
+            }
+        }
+        m_last_used = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start);
+        return run;
+    }
+
+	/// @brief Drops every queued job.
+    void clear() noexcept {
+        for (Ring& ring : m_rings) {
+            for (size_t i = 0; i < ring.size; ++i) ring.jobs[(ring.head + i) % m_config.capacity] = nullptr;
+            ring.head = 0;
+            ring.size = 0;
+        }
+    }
+
+	/// @brief Get the number of queued jobs of a priority.
+    [[nodiscard]] size_t size(WorkPriority priority) const noexcept { return m_rings[static_cast<size_t>(priority)].size; }
+	/// @brief Get the number of queued jobs over all priorities.
+    [[nodiscard]] size_t size() const noexcept {
+        size_t n = 0;
+        for (const Ring& ring : m_rings) n += ring.size;
+        return n;
+    }
+	/// @brief Returns whether no job is queued.
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+	/// @brief Get the maximum number of queued jobs per priority.
+    [[nodiscard]] size_t capacity() const noexcept { return m_config.capacity; }
+
+	/// @brief Get the budget the last run had (zero if the step itself used it up).
+    [[nodiscard]] std::chrono::nanoseconds last_budget() const noexcept { return m_last_budget; }
+	/// @brief Get the time the last run spent in jobs.
+    [[nodiscard]] std::chrono::nanoseconds last_used() const noexcept { return m_last_used; }
+	/// @brief Get the number of jobs that returned true (or threw) so far.
+    [[nodiscard]] uint64_t completed() const noexcept { return m_completed; }
+	/// @brief Get the number of job slices that returned after their deadline.
+    [[nodiscard]] uint64_t overruns() const noexcept { return m_overruns; }
+	/// @brief Get the queue configuration.
+    [[nodiscard]] const DeferredWorkConfig& config() const noexcept { return m_config; }
+
+private:
+	/// @brief Runs one job slice; a throwing job counts as finished and is dropped.
+    static bool call(Job& job, time_point deadline) noexcept {
+#if ISHAP_HAS_EXCEPTIONS
+        try {
+            return job(deadline);
+        } catch (...) {
+            // Swallow exceptions from user code to maintain noexcept guarantee
+            return true;
+        }
+#else
+        return job(deadline);
+#endif
+    }
+
+	/// @brief FIFO of one priority's jobs
+    struct Ring {
+        std::unique_ptr<Job[]>      jobs{};
+        size_t                      head{0};
+        size_t                      size{0};
+    };
+
+    DeferredWorkConfig                          m_config{};
+    std::array<Ring, k_work_priority_count>     m_rings{};
+    std::chrono::nanoseconds                    m_last_budget{0};
+    std::chrono::nanoseconds                    m_last_used{0};
+    uint64_t                                    m_completed{0};
+    uint64_t                                    m_overruns{0};
+};
+
+} // namespace ishap::timestep
@@ -0,0 +1,197 @@
+// delta_filter.hpp — frame delta smoothing and refresh-rate snapping
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - vsync'd frame deltas jitter around the refresh interval (16.4ms, 16.9ms,
+//   …); with a matching step, advance() runs 0 steps on one frame and 2 on
+//   the next, doubling the step cost of that frame and stuttering
+// - DeltaFilter runs before the clamp: a moving median or average over a
+//   short window estimates the frame time, which is then snapped to a whole
+//   multiple of the display refresh interval (configured, or detected from
+//   the median delta against the common refresh rates)
+// - Drift correction: the filter keeps the time it still owes (sum of raw
+//   minus sum of filtered deltas). Snapped frames repay it one whole refresh
+//   interval at a time, so the steps per frame stay steady; unsnapped frames
+//   repay a fraction of it. No time is lost or invented, and a display
+//   slightly off the snapping grid shows up as an occasional extra or
+//   skipped interval
+//
+// Usage
+//   ishap::timestep::DeltaFilter filter;              // median of 8, detected refresh
+//   filter = ishap::timestep::DeltaFilter{{.refresh_interval = ishap::timestep::k_step_120hz}};
+//   runner.set_delta_filter(&filter);
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_delta_filter_max_window           = 32;
+    inline constexpr size_t
+        k_default_delta_filter_window       = 8;
+    inline constexpr double
+        k_default_snap_tolerance            = 0.1;      // fraction of the refresh interval
+    inline constexpr double
+        k_default_drift_gain                = 0.125;    // fraction of the owed time repaid per unsnapped frame
+    inline constexpr std::chrono::nanoseconds
+        k_default_max_drift                 { 100'000'000 }; // 100ms
+    inline constexpr double
+        k_refresh_match_tolerance           = 0.05;     // relative error accepted when detecting the refresh rate
+    inline constexpr double
+        k_common_refresh_rates[]            = { 24.0, 30.0, 48.0, 50.0, 60.0, 72.0, 75.0, 90.0, 100.0,
+                                                120.0, 144.0, 165.0, 180.0, 200.0, 240.0, 360.0 };
+
+/// @brief How DeltaFilter smooths the raw deltas before snapping
+enum class DeltaFilterMode : uint8_t {
+    none        = 0,    ///< No smoothing, snapping and drift correction only
+    average     = 1,    ///< Moving average over the window (spreads spikes across the window)
+    median      = 2,    ///< Moving median over the window (ignores isolated spikes; owed time repays them)
+};
+
+	/// @brief Configuration settings for the delta filter
+struct DeltaFilterConfig {
+	/// @brief Smoothing mode (default: median)
+    DeltaFilterMode             mode                = DeltaFilterMode::median;
+	/// @brief Number of recent deltas smoothed over, 1..k_delta_filter_max_window (default: 8)
+    size_t                      window              = k_default_delta_filter_window;
+	/// @brief Snap filtered deltas to whole multiples of the refresh interval (default: true)
+    bool                        snap_to_refresh     = true;
+	/// @brief Refresh interval to snap to (default: 0 = detect from the median delta)
+    std::chrono::nanoseconds    refresh_interval    {0};
+	/// @brief Largest distance from a multiple that is snapped, as a fraction of the refresh interval (default: 0.1)
+    double                      snap_tolerance      = k_default_snap_tolerance;
+	/// @brief Fraction of the owed time added back per unsnapped frame (default: 0.125)
+    double                      drift_gain          = k_default_drift_gain;
+	/// @brief Owed time beyond which the excess is passed through at once (default: 100ms)
+    std::chrono::nanoseconds    max_drift           = k_default_max_drift;
+};
+
+/**
+* @brief Smooths and snaps raw frame deltas while preserving their total
+* @details Attach with set_delta_filter(); the runner filters every advancing delta before the
+*          safety_max_delta clamp. Fixed-size state, no allocations; not thread-safe.
+*/
+class DeltaFilter {
+public:
+    using rep = std::chrono::nanoseconds::rep;
+
+	/**
+	* @brief Constructs a filter.
+	* @param config The filter configuration; the window is clamped to 1..k_delta_filter_max_window.
+	*/
+    explicit DeltaFilter(DeltaFilterConfig config = {}) noexcept : m_config(config) {
+        if (m_config.window == 0) m_config.window = 1;
+        if (m_config.window > k_delta_filter_max_window) m_config.window = k_delta_filter_max_window;
+        if (m_config.drift_gain < 0.0) m_config.drift_gain = 0.0;
+        if (m_config.drift_gain > 1.0) m_config.drift_gain = 1.0;
+        if (m_config.max_drift.count() < 0) m_config.max_drift = std::chrono::nanoseconds(0);
+    }
+
+	/**
+	* @brief Filters one frame delta.
+	* @param raw The raw frame delta. Negative values are treated as zero.
+	* @return The delta to feed the accumulator.
+	*/
+    [[nodiscard]] std::chrono::nanoseconds filter(std::chrono::nanoseconds raw) noexcept {
+        const rep r = raw.count() > 0 ? raw.count() : rep{0};
+        if (m_count == m_config.window) m_sum -= m_samples[m_next];
+        else                            ++m_count;
+        m_samples[m_next] = r;
+        m_sum += r;
+        m_next = (m_next + 1) % m_config.window;
+        m_owed += r;
+
+        // Estimate the frame time
+        rep estimate = r;
+        if (m_config.mode == DeltaFilterMode::average)     estimate = m_sum / static_cast<rep>(m_count);
+        else if (m_config.mode == DeltaFilterMode::median) estimate = median();
+
+        if (m_config.snap_to_refresh) {
+            if (m_config.refresh_interval.count() > 0) m_refresh = m_config.refresh_interval.count();
+            else if (const rep detected = detect_refresh(); detected > 0) m_refresh = detected;
+        }
+
+        rep out = 0;
+        if (rep k = 0; snap(estimate, k)) {
+            // Snapped: repay owed time in whole refresh intervals to keep the grid
+            out = k * m_refresh;
+            const rep left = m_owed - out;
+            if (left >= m_refresh)        out += m_refresh;
+            else if (left <= -m_refresh)  out -= m_refresh;
+        } else {
+            out = estimate + static_cast<rep>(static_cast<double>(m_owed - estimate) * m_config.drift_gain);
+        }
+
+        // Bound the owed time [Safety]
+        const rep left = m_owed - out;
+        if (left > m_config.max_drift.count())  out += left - m_config.max_drift.count();
+        if (left < -m_config.max_drift.count()) out -= -m_config.max_drift.count() - left;
+        if (out < 0) out = 0;
+        m_owed -= out;
+        return std::chrono::nanoseconds(out);
+    }
+
+	/// @brief Forgets the window, the detected refresh interval and the owed time.
+    void reset() noexcept {
+        m_count = 0; m_next = 0; m_sum = 0; m_owed = 0; m_refresh = 0;
+    }
+
+	/// @brief Get the refresh interval snapped to: configured, or the last one detected (0 if none yet).
+    [[nodiscard]] std::chrono::nanoseconds refresh_interval() const noexcept { return std::chrono::nanoseconds(m_refresh); }
+	/// @brief Get the time owed to the accumulator: raw total minus filtered total (negative if ahead).
+    [[nodiscard]] std::chrono::nanoseconds drift() const noexcept { return std::chrono::nanoseconds(m_owed); }
+	/// @brief Get the filter configuration.
+    [[nodiscard]] const DeltaFilterConfig& config() const noexcept { return m_config; }
+
+private:
+	/// @brief Finds the multiple of the refresh interval within snap tolerance of a delta, if any.
+    [[nodiscard]] bool snap(rep delta, rep& multiple) const noexcept {
+        if (!m_config.snap_to_refresh || m_refresh <= 0) return false;
+        multiple = (delta + m_refresh / 2) / m_refresh;
+        const rep snapped = multiple * m_refresh;
+        const rep distance = delta > snapped ? delta - snapped : snapped - delta;
+        return multiple > 0 && static_cast<double>(distance) <= m_config.snap_tolerance * static_cast<double>(m_refresh);
+    }
+
+    [[nodiscard]] rep median() const noexcept {
+        std::array<rep, k_delta_filter_max_window> sorted{};
+        std::copy(m_samples.begin(), m_samples.begin() + static_cast<std::ptrdiff_t>(m_count), sorted.begin());
+        const auto mid = sorted.begin() + static_cast<std::ptrdiff_t>(m_count / 2);
+        std::nth_element(sorted.begin(), mid, sorted.begin() + static_cast<std::ptrdiff_t>(m_count));
+        return *mid;
+    }
+
+	/// @brief Matches the median raw delta against the common refresh rates; 0 when none is close (the last match is kept).
+    [[nodiscard]] rep detect_refresh() const noexcept {
+        const double m = static_cast<double>(median());
+        if (m <= 0.0) return 0;
+        rep best = 0;
+        double best_error = k_refresh_match_tolerance;
+        for (const double hz : k_common_refresh_rates) {
+            const double interval = 1e9 / hz;
+            const double error = (m > interval ? m - interval : interval - m) / interval;
+            if (error <= best_error) { best_error = error; best = static_cast<rep>(interval + 0.5); }
+        }
+        return best;
+    }
+
+private:
+    DeltaFilterConfig                                   m_config{};
+	/// @brief Ring of the last `window` raw deltas
+    std::array<rep, k_delta_filter_max_window>          m_samples{};
+    size_t                                              m_next{0};
+    size_t                                              m_count{0};
+	/// @brief Running sum of the window
+    rep                                                 m_sum{0};
+	/// @brief Raw total minus filtered total
+    rep                                                 m_owed{0};
+    rep                                                 m_refresh{0};
+};
+
+} // namespace ishap::timestep
@@ -0,0 +1,64 @@
+// error_policy.hpp — compile-time handling of exceptions thrown by user callables
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Wrapping every step in try / catch adds code to the hottest loop and
+//   keeps the compiler from treating the call as a plain, inlinable call
+// - The policy is a template parameter of BasicFixedTimestepRunner:
+//   CatchAndReport (catch, set step_error_caught(), call the error function),
+//   PropagateErrors (no catch; exceptions leave tick() / push_time()), or
+//   NoErrorHandling (no catch; a throwing step terminates)
+// - AutoErrorPolicy, the default, catches only around callables that are
+//   not nothrow-invocable, so a noexcept step compiles down to a bare call
+// - Without exception support (-fno-exceptions, /EHs-) every policy
+//   behaves as NoErrorHandling; ISHAP_HAS_EXCEPTIONS reports the detection
+//
+// Usage
+//   ishap::timestep::BasicFixedTimestepRunner fast{
+//       [&](std::chrono::nanoseconds dt) noexcept { physics.step(dt); }   // no try / catch
+//   };
+//   ishap::timestep::BasicFixedTimestepRunner<Step, ishap::timestep::NoErrorFunction,
+//       std::chrono::steady_clock, ishap::timestep::PropagateErrors> strict{step};
+//
+#pragma once
+
+#include <type_traits>
+
+#ifndef ISHAP_HAS_EXCEPTIONS
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define ISHAP_HAS_EXCEPTIONS 1
+#else
+#define ISHAP_HAS_EXCEPTIONS 0
+#endif
+#endif
+
+namespace ishap::timestep {
+
+/// @brief Catch every exception from user callables, record it and call the error function
+struct CatchAndReport {};
+/**
+* @brief Let exceptions from user callables propagate out of tick() / push_time() / fast_forward()
+* @details The step that threw (for a batch function, the whole batch) counts as run: its time has left the
+*          accumulator and step_index() is past it. The last_*() accessors still describe the previous tick.
+*/
+struct PropagateErrors {};
+/// @brief Never catch; user callables must not throw (an exception terminates)
+struct NoErrorHandling {};
+/// @brief CatchAndReport around callables that may throw, NoErrorHandling around nothrow ones
+struct AutoErrorPolicy {};
+
+namespace detail {
+
+    /// @brief True when a call to F with Args is wrapped in try / catch under Policy
+    template <class Policy, class F, class... Args>
+    inline constexpr bool catches_errors_v = ISHAP_HAS_EXCEPTIONS &&
+        (std::is_same_v<Policy, CatchAndReport> ||
+         (std::is_same_v<Policy, AutoErrorPolicy> && !std::is_nothrow_invocable_v<F, Args...>));
+
+    /// @brief True when the runner's entry points may throw under Policy
+    template <class Policy>
+    inline constexpr bool propagates_errors_v = ISHAP_HAS_EXCEPTIONS && std::is_same_v<Policy, PropagateErrors>;
+
+} // namespace detail
+
+} // namespace ishap::timestep
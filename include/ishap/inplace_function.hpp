@@ -0,0 +1,167 @@
+// inplace_function.hpp — type-erased callable with fixed in-object storage and no heap use
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - std::function keeps only small captures inline (16 bytes in libstdc++);
+//   larger step lambdas are heap-allocated by set_step_function(), and each
+//   call chases a pointer into a separate allocation
+// - InplaceFunction<Sig, Capacity> stores the callable inside the object:
+//   a capture larger than Capacity (or over-aligned) is a compile error
+//   with a static_assert naming the limit, never a silent allocation
+// - Still type-erased and runtime-swappable, so runners of one type can hold
+//   different steps; state and dispatch table sit next to the runner in
+//   pools of runners
+// - A noexcept signature (void(std::chrono::nanoseconds) noexcept) only
+//   accepts nothrow callables and makes the call nothrow-invocable, so
+//   AutoErrorPolicy drops the try / catch around it
+//
+// Usage
+//   ishap::timestep::InplaceFixedTimestepRunner<64> runner{
+//       [&world, cfg](std::chrono::nanoseconds dt){ world.step(dt, cfg); }
+//   };
+//   using Step = ishap::timestep::InplaceFunction<void(std::chrono::nanoseconds) noexcept, 48>;
+//
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_default_inplace_capacity          = 32;   // bytes of capture storage
+
+namespace detail {
+
+    /**
+	* @brief Storage and dispatch shared by the InplaceFunction specializations
+	* @tparam Capacity Bytes of in-object storage for the callable.
+	* @tparam Align Alignment of the storage.
+	* @tparam Nothrow Whether the signature is noexcept.
+	* @tparam R Return type.
+	* @tparam Args Argument types.
+	*/
+    template <size_t Capacity, size_t Align, bool Nothrow, class R, class... Args>
+    class InplaceFunctionBase {
+    public:
+        InplaceFunctionBase() noexcept = default;
+        InplaceFunctionBase(std::nullptr_t) noexcept {}
+
+        template <class F, class D = std::decay_t<F>,
+                  class = std::enable_if_t<!std::is_base_of_v<InplaceFunctionBase, D> && !std::is_same_v<D, std::nullptr_t>>>
+        InplaceFunctionBase(F&& fn) {
+            static_assert(sizeof(D) <= Capacity,
+                          "InplaceFunction: the callable (its captures) is larger than Capacity; raise the capacity");
+            static_assert(alignof(D) <= Align, "InplaceFunction: the callable is over-aligned for the storage");
+            static_assert(std::is_copy_constructible_v<D>, "InplaceFunction: the callable must be copy constructible");
+            static_assert(std::is_nothrow_move_constructible_v<D>, "InplaceFunction: the callable must be nothrow move constructible");
+            if constexpr (Nothrow) {
+                static_assert(std::is_nothrow_invocable_r_v<R, D&, Args...>,
+                              "InplaceFunction: a noexcept signature needs a noexcept callable");
+            } else {
+                static_assert(std::is_invocable_r_v<R, D&, Args...>, "InplaceFunction: the callable does not match the signature");
+            }
+            if constexpr (std::is_pointer_v<std::remove_reference_t<F>> || std::is_member_pointer_v<std::remove_reference_t<F>>) {
+                if (fn == nullptr) return;
+            }
+            ::new (static_cast<void*>(m_storage)) D(std::forward<F>(fn));
+            m_ops = &k_ops<D>;
+        }
+
+        InplaceFunctionBase(const InplaceFunctionBase& other) {
+            if (other.m_ops) { other.m_ops->copy(m_storage, other.m_storage); m_ops = other.m_ops; }
+        }
+        InplaceFunctionBase(InplaceFunctionBase&& other) noexcept {
+            if (other.m_ops) { other.m_ops->move(m_storage, other.m_storage); m_ops = other.m_ops; other.m_ops = nullptr; }
+        }
+
+        InplaceFunctionBase& operator=(const InplaceFunctionBase& other) {
+            if (this != &other) { InplaceFunctionBase copy(other); *this = std::move(copy); }
+            return *this;
+        }
+        InplaceFunctionBase& operator=(InplaceFunctionBase&& other) noexcept {
+            if (this != &other) {
+                reset();
+                if (other.m_ops) { other.m_ops->move(m_storage, other.m_storage); m_ops = other.m_ops; other.m_ops = nullptr; }
+            }
+            return *this;
+        }
+        InplaceFunctionBase& operator=(std::nullptr_t) noexcept { reset(); return *this; }
+
+        ~InplaceFunctionBase() { reset(); }
+
+		/// @brief Invokes the stored callable. Calling an empty function is undefined.
+        R operator()(Args... args) const noexcept(Nothrow) {
+            return m_ops->invoke(const_cast<unsigned char*>(m_storage), std::forward<Args>(args)...);
+        }
+
+		/// @brief Returns whether a callable is stored.
+        explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+		/// @brief Destroys the stored callable, if any.
+        void reset() noexcept {
+            if (m_ops) { m_ops->destroy(m_storage); m_ops = nullptr; }
+        }
+
+		/// @brief Get the in-object storage size in bytes.
+        [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+    private:
+		/// @brief Per-type dispatch table
+        struct Ops {
+            R    (*invoke)(void*, Args&&...) noexcept(Nothrow);
+            void (*copy)(void* dst, const void* src);
+            void (*move)(void* dst, void* src) noexcept;
+            void (*destroy)(void*) noexcept;
+        };
+
+        template <class D>
+        static inline constexpr Ops k_ops{
+            [](void* p, Args&&... args) noexcept(Nothrow) -> R {
+                return static_cast<R>((*static_cast<D*>(p))(std::forward<Args>(args)...));
+            },
+            [](void* dst, const void* src) { ::new (dst) D(*static_cast<const D*>(src)); },
+            [](void* dst, void* src) noexcept {
+                ::new (dst) D(std::move(*static_cast<D*>(src)));
+                static_cast<D*>(src)->~D();
+            },
+            [](void* p) noexcept { static_cast<D*>(p)->~D(); },
+        };
+
+        alignas(Align) unsigned char    m_storage[Capacity];
+		/// @brief Dispatch table of the stored type; nullptr when empty. A move leaves the source empty.
+        const Ops*                      m_ops{nullptr};
+    };
+
+} // namespace detail
+
+/**
+* @brief Type-erased callable stored in place, never on the heap
+* @tparam Sig Function signature, e.g. void(std::chrono::nanoseconds) or void() noexcept.
+* @tparam Capacity Bytes of storage for the callable; larger callables fail to compile.
+* @tparam Align Alignment of the storage.
+*/
+template <class Sig, size_t Capacity = k_default_inplace_capacity, size_t Align = alignof(std::max_align_t)>
+class InplaceFunction;
+
+template <class R, class... Args, size_t Capacity, size_t Align>
+class InplaceFunction<R(Args...), Capacity, Align>
+    : public detail::InplaceFunctionBase<Capacity, Align, false, R, Args...> {
+    using base = detail::InplaceFunctionBase<Capacity, Align, false, R, Args...>;
+public:
+    using base::base;
+    InplaceFunction() noexcept = default;
+};
+
+template <class R, class... Args, size_t Capacity, size_t Align>
+class InplaceFunction<R(Args...) noexcept, Capacity, Align>
+    : public detail::InplaceFunctionBase<Capacity, Align, true, R, Args...> {
+    using base = detail::InplaceFunctionBase<Capacity, Align, true, R, Args...>;
+public:
+    using base::base;
+    InplaceFunction() noexcept = default;
+};
+
+} // namespace ishap::timestep
@@ -4,9 +4,29 @@
 // Rationale
 // - Clean, unit-safe API using std::chrono
 // - Works with either a real clock (tick()) or external dt feed (push_time())
+// - Pluggable clock policy: steady_clock by default, TSC or manual clocks in clock.hpp
 // - Deterministic stepping (when fed explicit dt)
+// - Optional delta smoothing and refresh-rate snapping before the clamp (see delta_filter.hpp)
 // - Time scaling, max-delta clamp, substep cap, alpha for interpolation
+//   (vectorized SoA lerp / nlerp kernels in interpolate.hpp)
+// - Opt-in lock-free telemetry ring and step-start lateness histogram (see telemetry.hpp)
+// - Optional per-step cost statistics (ISHAP_ENABLE_STEP_TIMING, see step_timing.hpp)
+// - Optional timeline tracing of ticks, steps and trims (ISHAP_ENABLE_TRACING, see trace.hpp)
+// - Optional input recording for deterministic replay (see recorder.hpp / replay.hpp)
+// - Opt-in adaptive step rate under sustained overload (see adaptive_rate.hpp)
+// - Non-blocking control channel for pause / time scale / rate changes from other threads (see control_channel.hpp)
+// - Optional deferred work run in the step's leftover budget (see deferred_work.hpp)
+// - Headless fast_forward() by a step count or a duration, bypassing the clamps
+// - Step index with rollback_to() / resimulate() for rollback netcode (see rollback.hpp)
+// - Optional pacing driver (wait_for_next_step / run_until): coarse sleep,
+//   then a short spin before each step deadline; in epoll loops, a Linux
+//   timerfd armed at each deadline (see timerfd.hpp); affinity / real-time
+//   priority for the pacing thread in thread_tuning.hpp
 // - Header-only; no exceptions; no allocations beyond std::function target
+//   (none with in-place callables, see inplace_function.hpp)
+// - Compile-time error policy: try / catch only around steps that may throw (see error_policy.hpp)
+// - BasicFixedTimestepRunner<StepFn, ErrorFn> stores callables by value so
+//   the step loop can inline them; FixedTimestepRunner keeps std::function
 //
 // Usage
 //   ishap::timestep::FixedTimestepRunner runner{
@@ -19,14 +39,40 @@
 //       // render(interpolate(a));
 //   }
 //
+//   // Dedicated sim thread: sleep until the next step is due, then tick
+//   std::atomic<bool> stop{false};
+//   runner.run_until(stop);
+//
+//   // Inlined step (no std::function dispatch in the step loop)
+//   ishap::timestep::BasicFixedTimestepRunner fast{
+//       [&](std::chrono::nanoseconds dt) noexcept { physics.step(dt); }
+//   };
+//
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
+#include "adaptive_rate.hpp"
+#include "control_channel.hpp"
+#include "deferred_work.hpp"
+#include "delta_filter.hpp"
+#include "error_policy.hpp"
+#include "inplace_function.hpp"
+#include "recorder.hpp"
+#include "step_timing.hpp"
+#include "telemetry.hpp"
+#include "trace.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
 namespace ishap::timestep {
 
     inline constexpr std::chrono::nanoseconds   
@@ -44,6 +90,22 @@ namespace ishap::timestep {
         k_default_max_accumulator_overflow  = 3;
     inline constexpr double                     
         k_default_time_scale                = 1.0;
+    inline constexpr std::chrono::nanoseconds   
+        k_default_wait_spin_slice           { 1'000'000 };   // 1ms
+    inline constexpr size_t                     
+        k_fast_forward_chunk                = 1024;          // steps between progress reports
+    inline constexpr size_t                     
+        k_default_catch_up_frames           = 8;
+    inline constexpr size_t                     
+        k_default_catch_up_max_extra_steps  = 2;
+    inline constexpr double                     
+        k_catch_up_frame_weight             = 1.0 / 16.0;    // EMA weight of the per-frame step baseline
+
+/// @brief What advance() does with steps that are due beyond what one tick may run
+enum class CatchUpPolicy : uint8_t {
+    drop        = 0,    ///< Run up to safety_max_substeps, keep at most safety_max_accumulator_overflow steps of debt
+    smooth      = 1,    ///< Run the usual steps per frame plus at most catch_up_max_extra_steps, spreading debt over catch_up_frames
+};
 
 	/// @brief Configuration settings for the timestep runner
 struct Config {
@@ -57,24 +119,170 @@ struct Config {
     size_t          			safety_max_substeps 				= k_default_max_substeps;
 	/// @brief Safety max accumulator overflow multiplier (default: 3)
 	size_t 						safety_max_accumulator_overflow 	= k_default_max_accumulator_overflow;
+	/// @brief Final slice before a step deadline that wait_for_next_step() spins instead of sleeping (default: 1ms)
+	std::chrono::nanoseconds 	wait_spin_slice 					= k_default_wait_spin_slice;
+	/// @brief Catch-up strategy for steps beyond one tick's share (default: drop)
+	CatchUpPolicy 				catch_up 							= CatchUpPolicy::drop;
+	/// @brief Smooth catch-up: number of frames over which accumulated debt is repaid (default: 8)
+	size_t 						catch_up_frames 					= k_default_catch_up_frames;
+	/// @brief Smooth catch-up: extra steps per frame above the usual count (default: 2)
+	size_t 						catch_up_max_extra_steps 			= k_default_catch_up_max_extra_steps;
 };
 
-/// @brief Fixed timestep runner for deterministic updates
-class FixedTimestepRunner {
+/// @brief Error callback placeholder used when no error function is wanted (never reported as set)
+struct NoErrorFunction {
+    void operator()() const noexcept {}
+};
+
+namespace detail {
+
+    /// @brief True for callables that carry an empty state (std::function, function pointers)
+    template <class F>
+    inline constexpr bool is_nullable_callable_v = std::is_constructible_v<bool, const F&>;
+
+    /// @brief Returns whether a stored callable is set; callables without an empty state always are
+    template <class F>
+    [[nodiscard]] constexpr bool is_callable_set(const F& fn) noexcept {
+        if constexpr (std::is_same_v<F, NoErrorFunction>)   { return false; }
+        else if constexpr (is_nullable_callable_v<F>)       { return static_cast<bool>(fn); }
+        else                                                { (void)fn; return true; }
+    }
+
+    /// @brief Invokes a stored callable, skipping the null check when the type has no empty state
+    template <class F, class... Args>
+    constexpr void invoke_if_set(F& fn, Args&&... args) {
+        if constexpr (is_nullable_callable_v<F>) { if (!fn) return; }
+        fn(std::forward<Args>(args)...);
+    }
+
+    /**
+	* @brief Clamps a raw frame delta to safety_max_delta and applies the time scale.
+	* @param raw_elapsed The raw elapsed time, as a std::chrono::nanoseconds duration.
+	* @param config The configuration providing the clamp and time scale.
+	* @return The delta to add to the accumulator.
+	*/
+    [[nodiscard]] inline std::chrono::nanoseconds scaled_delta(std::chrono::nanoseconds raw_elapsed,
+                                                               const Config& config) noexcept {
+		// Clamp [Safety]
+        std::chrono::nanoseconds dt = raw_elapsed;
+        if (dt > config.safety_max_delta) dt = config.safety_max_delta;
+
+		// Time scale
+        if (config.time_scale != 1.0) {
+			    dt = std::chrono::duration_cast<std::chrono::nanoseconds>(dt * config.time_scale);
+        }
+        return dt;
+    }
+
+    /**
+	* @brief Trims an accumulator to step * safety_max_accumulator_overflow.
+	* @param accumulator The accumulator to trim in place.
+	* @param config The configuration providing the step and overflow multiplier.
+	*/
+    inline void trim_accumulator(std::chrono::nanoseconds& accumulator, const Config& config) noexcept {
+		const std::chrono::nanoseconds max_acc = config.step * config.safety_max_accumulator_overflow;
+		if (accumulator > max_acc) { accumulator = max_acc; }
+    }
+
+    /**
+	* @brief Trims an accumulator to what the active catch-up policy can still repay.
+	* @details Smooth catch-up keeps up to catch_up_frames * catch_up_max_extra_steps steps of debt on top of
+	*          the safety_max_accumulator_overflow allowance; drop trims as trim_accumulator().
+	* @param accumulator The accumulator to trim in place.
+	* @param config The configuration providing the step, overflow multiplier and catch-up settings.
+	*/
+    inline void trim_accumulator_for_catch_up(std::chrono::nanoseconds& accumulator, const Config& config) noexcept {
+		size_t overflow = config.safety_max_accumulator_overflow;
+		if (config.catch_up == CatchUpPolicy::smooth) {
+			overflow += config.catch_up_frames * config.catch_up_max_extra_steps;
+		}
+		const std::chrono::nanoseconds max_acc = config.step * static_cast<std::chrono::nanoseconds::rep>(overflow);
+		if (accumulator > max_acc) { accumulator = max_acc; }
+    }
+
+    /// @brief CPU hint for busy-wait loops (pause / yield instruction where available)
+    inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    template <class T, class = void>
+    struct has_stop_requested : std::false_type {};
+    template <class T>
+    struct has_stop_requested<T, std::void_t<decltype(std::declval<const T&>().stop_requested())>> : std::true_type {};
+
+    /**
+	* @brief Queries a stop condition: a predicate, a std::stop_token-like object or an atomic flag.
+	* @param stop The stop condition.
+	* @return True when a stop has been requested.
+	*/
+    template <class Stop>
+    [[nodiscard]] bool stop_requested(Stop& stop) noexcept {
+        if constexpr (std::is_invocable_r_v<bool, Stop&>)   { return stop(); }
+        else if constexpr (has_stop_requested<Stop>::value) { return stop.stop_requested(); }
+        else                                                { return stop.load(std::memory_order_acquire); }
+    }
+
+    /// @brief Progress callback used when fast_forward() is given none: never cancels
+    struct NoProgress {
+        constexpr bool operator()(size_t, size_t) const noexcept { return true; }
+    };
+
+} // namespace detail
+
+/**
+* @brief Fixed timestep runner for deterministic updates
+* @tparam StepFn Callable invoked as void(std::chrono::nanoseconds) for each fixed step. Stored by value.
+* @tparam ErrorFn Callable invoked as void() when a step throws. Stored by value.
+* @tparam Clock Steady clock read by tick() and the pacing driver (std::chrono clock requirements,
+*         at least nanosecond precision). See clock.hpp for TscClock and ManualClock.
+* @tparam ErrorPolicy How exceptions from the step and batch functions are handled: AutoErrorPolicy,
+*         CatchAndReport, PropagateErrors or NoErrorHandling (see error_policy.hpp).
+*/
+template <class StepFn, class ErrorFn = NoErrorFunction, class Clock = std::chrono::steady_clock,
+          class ErrorPolicy = AutoErrorPolicy>
+class BasicFixedTimestepRunner {
+    static_assert(Clock::is_steady, "BasicFixedTimestepRunner needs a steady clock");
+    static_assert(std::is_convertible_v<std::chrono::nanoseconds, typename Clock::duration>,
+                  "BasicFixedTimestepRunner needs a clock with at least nanosecond precision");
 public:
-    using OnStepFunction = std::function<void(std::chrono::nanoseconds)>;
-    using OnErrorFunction = std::function<void()>;
+    using OnStepFunction = StepFn;
+    using OnErrorFunction = ErrorFn;
+    using OnBatchStepFunction = std::function<void(size_t, std::chrono::nanoseconds)>;
+    using clock_type = Clock;
+    using time_point = typename clock_type::time_point;
+    using error_policy = ErrorPolicy;
+
+	/// @brief Whether tick(), push_time(), fast_forward() and the pacing driver are noexcept
+    static constexpr bool k_nothrow = !detail::propagates_errors_v<ErrorPolicy>;
 
-    FixedTimestepRunner() = default;
+    BasicFixedTimestepRunner() = default;
 
 	/**
-	* @brief Constructs a FixedTimestepRunner with the given update function and configuration.
+	* @brief Constructs a BasicFixedTimestepRunner with the given update function and configuration.
 	* @param fn The function to call for each fixed update step. It takes a single parameter of type std::chrono::nanoseconds representing the fixed timestep duration.
 	* @param config The configuration for the timestep runner. Default values are provided if not specified
 	*/
-    explicit FixedTimestepRunner(OnStepFunction fn, Config config = {})
+    explicit BasicFixedTimestepRunner(OnStepFunction fn, Config config = {})
         : m_on_update_function(std::move(fn)), m_config(std::move(config)) { reset(true); }
 
+	/**
+	* @brief Constructs a BasicFixedTimestepRunner with the given update function, configuration and error function.
+	* @param fn The function to call for each fixed update step.
+	* @param config The configuration for the timestep runner.
+	* @param error_fn The function to call when a step error is caught.
+	*/
+    BasicFixedTimestepRunner(OnStepFunction fn, Config config, OnErrorFunction error_fn)
+        : m_on_update_function(std::move(fn)), m_config(std::move(config)),
+          m_on_error_function(std::move(error_fn)) { reset(true); }
+
     /**
 	* @brief Resets the internal state of the timestep runner.
 	* @param start_now If true, sets the last time point to the current time. Default is true.
@@ -84,16 +292,22 @@ public:
         m_accumulator 			= std::chrono::nanoseconds(0); 
         m_last_delta 			= std::chrono::nanoseconds(0);
         m_last_steps 			= 0;
+        m_last_dropped_steps 	= 0;
+        m_last_trimmed 			= std::chrono::nanoseconds(0);
+        m_last_deferred_steps 	= 0;
+        m_frame_steps_avg 		= -1.0;
+        m_catch_up_rate 		= 0;
         m_paused 				= false;
-        if (start_now) m_last 	= steady_clock::now();
+        if (start_now) { m_last = clock_type::now(); m_has_last = true; }
+        if (m_recorder) m_recorder->record_reset();
     }
 
 	/**
-	* @brief Advances the timestep runner using the current time from a steady clock.
+	* @brief Advances the timestep runner using the current time from the runner's clock.
 	* @return The interpolation alpha value in the range [0, 1), representing the
 	*         fraction of the next fixed timestep that has been accumulated.
 	*/
-    [[nodiscard]] double tick() noexcept { return tick_with_clock(steady_clock::now()); }
+    [[nodiscard]] double tick() noexcept(k_nothrow) { return tick_with_clock(clock_type::now()); }
 
 	/**
 	* @brief Advances the timestep runner using an externally provided elapsed time.
@@ -101,7 +315,78 @@ public:
 	* @return The interpolation alpha value in the range [0, 1), representing the
 	*         fraction of the next fixed timestep that has been accumulated.
 	*/
-    [[nodiscard]] double push_time(std::chrono::nanoseconds elapsed) noexcept { return advance(elapsed); }
+    [[nodiscard]] double push_time(std::chrono::nanoseconds elapsed) noexcept(k_nothrow) {
+        if (m_control) (void)m_control->apply(*this);
+        return advance(elapsed, time_point{});
+    }
+
+	/**
+	* @brief Runs a number of fixed steps back-to-back, as fast as possible.
+	* @param steps The number of steps to run.
+	* @param progress Callable invoked as progress(done, total) every k_fast_forward_chunk steps and after the
+	*        last one; returning false cancels the remaining steps. A void return never cancels.
+	* @return The number of steps executed.
+	* @details Ignores pause, safety_max_delta and safety_max_substeps, and leaves the accumulator, last time
+	*          point and per-tick telemetry untouched. Uses the batch step function, one call per chunk, when set.
+	*/
+    template <class Progress = detail::NoProgress>
+    size_t fast_forward(size_t steps, Progress&& progress = Progress{}) noexcept(k_nothrow) {
+        const size_t done = run_steps(steps, progress);
+        if (m_recorder) m_recorder->record_fast_forward_steps(done);
+        return done;
+    }
+
+	/**
+	* @brief Advances simulated time by a duration, as fast as possible.
+	* @param duration The unclamped elapsed time; the time scale still applies.
+	* @param progress As for fast_forward(size_t, Progress&&).
+	* @return The number of steps executed.
+	* @details On completion the leftover fraction of a step stays in the accumulator. If cancelled, the
+	*          accumulator keeps its previous value and the unexecuted time is discarded.
+	*/
+    template <class Progress = detail::NoProgress>
+    size_t fast_forward(std::chrono::nanoseconds duration, Progress&& progress = Progress{}) noexcept(k_nothrow) {
+        if (duration.count() <= 0) return 0;
+        std::chrono::nanoseconds dt = duration;
+        if (m_config.time_scale != 1.0) {
+            dt = std::chrono::duration_cast<std::chrono::nanoseconds>(dt * m_config.time_scale);
+        }
+        const std::chrono::nanoseconds total = m_accumulator + dt;
+        const auto steps = static_cast<size_t>(total / m_config.step);
+        const size_t done = run_steps(steps, progress);
+        if (done == steps) {
+            m_accumulator = total - m_config.step * static_cast<std::chrono::nanoseconds::rep>(steps);
+            if (m_recorder) m_recorder->record_fast_forward_time(duration);
+        } else if (m_recorder) {
+            m_recorder->record_fast_forward_steps(done);
+        }
+        return done;
+    }
+
+	/**
+	* @brief Rewinds the step index to an earlier tick, for rollback netcode.
+	* @param tick The tick to resume from; the next step simulates this tick. Must not exceed step_index().
+	* @return False (and no change) if tick is in the future.
+	* @details Only the index moves: the caller restores its own state for tick (see RollbackBuffer in
+	*          rollback.hpp). Not recorded; a replay that uses rollback must rewind the same way.
+	*/
+    bool rollback_to(uint64_t tick) noexcept {
+        if (tick > m_step_index) return false;
+        m_step_index = tick;
+        return true;
+    }
+
+	/**
+	* @brief Re-runs steps back-to-back after rollback_to(), as fast as possible.
+	* @param steps The number of steps to run.
+	* @return The number of steps executed.
+	* @details Same step path as fast_forward(), but leaves the accumulator, clock, per-tick telemetry and
+	*          recorder untouched: resimulated ticks replace ticks that were already counted.
+	*/
+    size_t resimulate(size_t steps) noexcept(k_nothrow) {
+        detail::NoProgress progress{};
+        return run_steps(steps, progress);
+    }
 
     /**
 	* @brief Sets the target fixed update rate in Hertz.
@@ -112,6 +397,7 @@ public:
             if (hz <= 0.0) return;
             m_config.step = std::chrono::duration_cast
 			<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / hz)); 
+            if (m_recorder) m_recorder->record_step(m_config.step);
         }
 
     /// @brief Get the current fixed update rate in Hertz.
@@ -125,6 +411,7 @@ public:
     void   set_step(std::chrono::nanoseconds s) noexcept { 
         if (s.count() <= 0) return;
         m_config.step = s; 
+        if (m_recorder) m_recorder->record_step(m_config.step);
     }
 
 	/// @brief Get the current fixed timestep duration in nanoseconds.
@@ -138,6 +425,7 @@ public:
     void   set_max_delta(std::chrono::nanoseconds d) noexcept {
         if (d.count() <= 0) return;
         m_config.safety_max_delta = d; 
+        if (m_recorder) m_recorder->record_max_delta(d);
         }
 
 	/// @brief Get the current maximum allowed delta time in nanoseconds.
@@ -150,6 +438,7 @@ public:
 	*/
     void    set_max_substeps(size_t n) noexcept { 
         m_config.safety_max_substeps = (n > 0 ? n : size_t{1}); 
+        if (m_recorder) m_recorder->record_max_substeps(m_config.safety_max_substeps);
     }
 	/// @brief Get the current maximum number of fixed update steps per tick.
     [[nodiscard]] size_t    max_substeps() const noexcept     { return m_config.safety_max_substeps; }
@@ -164,22 +453,103 @@ public:
     void   set_time_scale(double s) noexcept {
         if (s < 0.0) s = 0.0;
          m_config.time_scale = s; 
+        if (m_recorder) m_recorder->record_time_scale(s);
         }
 	/// @brief Get the current time scale factor.
     [[nodiscard]] double time_scale() const noexcept            { return m_config.time_scale; }
 
+	/**
+	* @brief Selects how steps beyond one tick's share are handled.
+	* @param policy CatchUpPolicy::drop (run up to safety_max_substeps, trim the rest) or CatchUpPolicy::smooth.
+	* @param frames Smooth: frames over which accumulated debt is repaid. Zero is treated as 1.
+	* @param max_extra_steps Smooth: extra steps per frame above the usual count. Zero never repays debt.
+	*/
+    void   set_catch_up(CatchUpPolicy policy, size_t frames = k_default_catch_up_frames,
+                        size_t max_extra_steps = k_default_catch_up_max_extra_steps) noexcept {
+        m_config.catch_up                   = policy;
+        m_config.catch_up_frames            = (frames > 0 ? frames : size_t{1});
+        m_config.catch_up_max_extra_steps   = max_extra_steps;
+        m_catch_up_rate                     = 0;
+        if (m_recorder) m_recorder->record_catch_up(static_cast<uint8_t>(policy), m_config.catch_up_frames, max_extra_steps);
+    }
+	/// @brief Get the current catch-up policy.
+    [[nodiscard]] CatchUpPolicy catch_up() const noexcept       { return m_config.catch_up; }
+
+	/**
+	* @brief Sets the final slice before a step deadline that wait_for_next_step() busy-waits.
+	* @param s The spin slice. Zero disables spinning (pure sleep); negative values are clamped to zero.
+	*/
+    void   set_wait_spin_slice(std::chrono::nanoseconds s) noexcept {
+        m_config.wait_spin_slice = (s.count() < 0 ? std::chrono::nanoseconds(0) : s);
+    }
+	/// @brief Get the current wait spin slice.
+    [[nodiscard]] std::chrono::nanoseconds wait_spin_slice() const noexcept { return m_config.wait_spin_slice; }
+
+	/**
+	* @brief Get the point in time at which the next fixed step becomes due.
+	* @return The deadline relative to the last tick(), accounting for the accumulator and time scale,
+	*         or time_point::max() when paused or the time scale is zero.
+	* @details Only meaningful when the runner is driven by tick(); push_time() does not move the last time point.
+	*/
+    [[nodiscard]] time_point next_step_deadline() const noexcept {
+        if (m_paused || m_config.time_scale <= 0.0) return time_point::max();
+        const std::chrono::nanoseconds remaining = m_config.step - m_accumulator;
+        if (remaining.count() <= 0) return m_last;
+        if (m_config.time_scale == 1.0) return m_last + remaining;
+        return m_last + std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double, std::nano>(static_cast<double>(remaining.count()) / m_config.time_scale));
+    }
+
+	/**
+	* @brief Blocks until the next fixed step is due, then ticks the runner.
+	* @details Sleeps until wait_spin_slice() before the deadline, then spins for the remainder, trading a
+	*          short burst of CPU for step-start latency well below the OS sleep granularity.
+	*          While paused, it waits one step duration between ticks. With a deadline histogram attached,
+	*          each wake-up past a real step deadline is recorded in it.
+	* @return The interpolation alpha value returned by tick().
+	*/
+    double wait_for_next_step() noexcept(k_nothrow) {
+        time_point deadline = next_step_deadline();
+        const bool due = deadline != time_point::max();
+        time_point now = clock_type::now();
+        if (!due) deadline = now + m_config.step;
+        const time_point spin_from = deadline - m_config.wait_spin_slice;
+        if (now < spin_from) {
+            std::this_thread::sleep_until(spin_from);
+            now = clock_type::now();
+        }
+        while (now < deadline) {
+            detail::cpu_relax();
+            now = clock_type::now();
+        }
+        if (m_deadline_histogram && due) {
+            m_deadline_histogram->record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline));
+        }
+        return tick();
+    }
+
+	/**
+	* @brief Drives the runner with wait_for_next_step() until a stop is requested.
+	* @param stop A bool() predicate, a std::stop_token (or anything with stop_requested()), or a std::atomic<bool>.
+	*             Checked once before every step wait.
+	*/
+    template <class Stop>
+    void run_until(Stop&& stop) noexcept(k_nothrow) {
+        while (!detail::stop_requested(stop)) (void)wait_for_next_step();
+    }
+
 	/**
 	* @brief Pauses or unpauses the timestep runner.
 	* @param p If true, pauses the runner; if false, unpauses it. Default is true.
 	* When paused, calls to tick() or push_time() will not advance time or call the update function.
 	*/
-    void   pause(bool p=true) noexcept      { m_paused = p; }
+    void   pause(bool p=true) noexcept      { m_paused = p; if (m_recorder) m_recorder->record_pause(m_paused); }
 	/// @brief Returns whether the timestep runner is currently paused.
     [[nodiscard]] bool   paused() const noexcept               { return m_paused; }
 	/// @brief Unpauses the timestep runner. Alias for pause(false).
-	void   resume() noexcept                { m_paused = false; }
+	void   resume() noexcept                { pause(false); }
 	/// @brief Toggles the paused state of the timestep runner.
-	void   toggle_pause() noexcept          { m_paused = !m_paused; }
+	void   toggle_pause() noexcept          { pause(!m_paused); }
 
     /**
 	* @brief Get the current accumulator value.
@@ -196,6 +566,29 @@ public:
 	* @return The number of fixed update steps executed during the last call to tick() or push_time().
 	*/
     [[nodiscard]] size_t                    last_steps() const noexcept     { return m_last_steps; } 
+	/**
+	* @brief Get the index of the next step to run; inside the step function, the tick being simulated
+	*        (the first tick of the batch inside the batch step function).
+	* @return Steps executed since construction, less any rollback_to(). Not cleared by reset().
+	*/
+    [[nodiscard]] uint64_t                  step_index() const noexcept     { return m_step_index; }
+	/// @brief Sets the step index, e.g. to match a tick received from a server.
+    void                                    set_step_index(uint64_t tick) noexcept { m_step_index = tick; }
+	/**
+	* @brief Get the number of due steps the last tick left unexecuted because of safety_max_substeps.
+	* @return The number of dropped (deferred to the accumulator) steps during the last tick.
+	*/
+    [[nodiscard]] size_t                    last_dropped_steps() const noexcept { return m_last_dropped_steps; }
+	/**
+	* @brief Get the number of whole steps of debt carried to later ticks after the accumulator trim.
+	* @return The deferred steps of the last tick; last_dropped_steps() minus this many were thrown away.
+	*/
+    [[nodiscard]] size_t                    last_deferred_steps() const noexcept { return m_last_deferred_steps; }
+	/**
+	* @brief Get the time discarded by the accumulator trim during the last tick.
+	* @return The trimmed time as a std::chrono::nanoseconds duration.
+	*/
+    [[nodiscard]] std::chrono::nanoseconds  last_trimmed() const noexcept   { return m_last_trimmed; }
 	/**
 	* @brief Get the interpolation factor for the last frame.
 	* @return The interpolation factor as a double in the range [0, 1].
@@ -205,7 +598,89 @@ public:
 			        static_cast<double>(m_config.step.count()); 
     }
 
-     /// @brief Returns whether a step error was caught in user code during the last tick.
+    /**
+	* @brief Attaches a telemetry ring that receives one record per tick.
+	* @param ring The ring to push into, or nullptr to detach. Not owned; must outlive the attachment.
+	* @details The runner is the ring's single producer; any one other thread may consume it.
+	*/
+    void   set_telemetry_ring(TelemetryRing* ring) noexcept { m_telemetry = ring; }
+	/// @brief Get the attached telemetry ring, if any.
+    [[nodiscard]] TelemetryRing* telemetry_ring() const noexcept { return m_telemetry; }
+
+    /**
+	* @brief Attaches a histogram of step-start lateness, filled by wait_for_next_step() and TimerFdDriver.
+	* @param histogram The histogram to record into, or nullptr to detach. Not owned; must outlive the attachment.
+	* @details The runner's thread is the single writer; any thread may read it.
+	*/
+    void   set_deadline_histogram(DeadlineHistogram* histogram) noexcept { m_deadline_histogram = histogram; }
+	/// @brief Get the attached deadline histogram, if any.
+    [[nodiscard]] DeadlineHistogram* deadline_histogram() const noexcept { return m_deadline_histogram; }
+
+    /**
+	* @brief Attaches a recorder that logs raw deltas, pause state, resets and config changes.
+	* @param recorder The recorder to write to, or nullptr to detach. Not owned.
+	* @details Replaying the file with a Replayer into an identically configured runner reproduces the run.
+	*/
+    void   set_recorder(Recorder* recorder) noexcept { m_recorder = recorder; }
+	/// @brief Get the attached recorder, if any.
+    [[nodiscard]] Recorder* recorder() const noexcept { return m_recorder; }
+
+    /**
+	* @brief Attaches an adaptive rate controller that lengthens the step under sustained overload.
+	* @param controller The controller to consult after every advancing tick, or nullptr to detach. Not owned.
+	* @details A controller without a base step adopts the current step. Rate changes are applied with
+	*          set_step() at the end of the tick. Detaching leaves the current step in place.
+	*/
+    void   set_rate_controller(AdaptiveRateController* controller) noexcept {
+        m_rate_controller = controller;
+        if (m_rate_controller) m_rate_controller->bind(m_config.step);
+    }
+	/// @brief Get the attached adaptive rate controller, if any.
+    [[nodiscard]] AdaptiveRateController* rate_controller() const noexcept { return m_rate_controller; }
+
+    /**
+	* @brief Attaches a delta filter that smooths and snaps every advancing delta before the clamp.
+	* @param filter The filter to apply, or nullptr to detach. Not owned.
+	* @details last_delta() and telemetry keep reporting the raw delta; an attached recorder logs the
+	*          filtered one, so replay reproduces the run without a filter attached.
+	*/
+    void   set_delta_filter(DeltaFilter* filter) noexcept { m_delta_filter = filter; }
+	/// @brief Get the attached delta filter, if any.
+    [[nodiscard]] DeltaFilter* delta_filter() const noexcept { return m_delta_filter; }
+
+    /**
+	* @brief Attaches a queue of optional jobs run in the leftover budget of each tick's last step.
+	* @param queue The queue to run, or nullptr to detach. Not owned.
+	* @details Nothing runs on ticks that leave a step due (dropped steps), nor in fast_forward() or resimulate().
+	*/
+    void   set_deferred_work(DeferredWorkQueue* queue) noexcept { m_deferred_work = queue; }
+	/// @brief Get the attached deferred work queue, if any.
+    [[nodiscard]] DeferredWorkQueue* deferred_work() const noexcept { return m_deferred_work; }
+
+    /**
+	* @brief Attaches a control channel whose pending settings are applied at the start of every tick() / push_time().
+	* @param channel The channel other threads post to, or nullptr to detach. Not owned.
+	* @details Settings go through the regular setters on the ticking thread, so they are recorded like local calls.
+	*          Attach before the runner is shared; only the channel is safe to use from other threads.
+	*/
+    void   set_control_channel(ControlChannel* channel) noexcept { m_control = channel; }
+	/// @brief Get the attached control channel, if any.
+    [[nodiscard]] ControlChannel* control_channel() const noexcept { return m_control; }
+
+#if ISHAP_ENABLE_STEP_TIMING
+    /**
+	* @brief Attaches step cost statistics, fed with the execution time of every step.
+	* @param stats The statistics to record into, or nullptr to detach. Not owned.
+	* @details For batch steps the cost of the batch call is divided evenly across its steps.
+	*          The overrun callback runs inside the step loop under the runner's error policy: an exception from it
+	*          is handled like a step error (step_error_caught(), the error function, or propagated).
+	*/
+    void   set_step_timing(StepTimingStats* stats) noexcept { m_step_timing = stats; }
+	/// @brief Get the attached step cost statistics, if any.
+    [[nodiscard]] StepTimingStats* step_timing() const noexcept { return m_step_timing; }
+#endif
+
+     /// @brief Returns whether a step error was caught in user code during the last tick (always false when the policy does not catch).
     [[nodiscard]] bool step_error_caught() const noexcept { return m_step_error_caught; }
 
     /**
@@ -215,7 +690,20 @@ public:
     void   set_step_function(OnStepFunction fn)          { m_on_update_function = std::move(fn); }
 	/// @brief Returns whether a step function is set.
     [[nodiscard]] bool   has_step_function() const noexcept {
-        return static_cast<bool>(m_on_update_function);
+        return detail::is_callable_set(m_on_update_function);
+    }
+
+    /**
+	* @brief Sets the batch step function, called once per tick with all pending steps.
+	* @param fn The batch function, taking the number of steps to run and the fixed step duration.
+	* @details When set, it replaces per-step calls to the step function. The step count follows the
+	*          same safety_max_substeps and accumulator rules as the regular step loop, and the
+	*          function is only called when at least one step is due.
+	*/
+    void   set_batch_step_function(OnBatchStepFunction fn) { m_on_batch_function = std::move(fn); }
+	/// @brief Returns whether a batch step function is set.
+    [[nodiscard]] bool   has_batch_step_function() const noexcept {
+        return static_cast<bool>(m_on_batch_function);
     }
 
     /**
@@ -225,25 +713,25 @@ public:
     void set_error_function(OnErrorFunction fn) { m_on_error_function = std::move(fn); }
     /// @brief Returns whether an error function is set.
     [[nodiscard]] bool has_error_function() const noexcept {
-         return static_cast<bool>(m_on_error_function); 
+         return detail::is_callable_set(m_on_error_function); 
         }
 
 
 private:
-    using steady_clock 				= std::chrono::steady_clock;
-
 	/**
-	* @brief Advances the timestep runner using a provided time point from a steady clock.
-	* @param tick_timepoint The current time point from a steady clock.
+	* @brief Advances the timestep runner using a provided time point from the runner's clock.
+	* @param tick_timepoint The current time point from the runner's clock.
 	* @return The interpolation alpha value in the range [0, 1), representing the
 	*         fraction of the next fixed timestep that has been accumulated.
 	*/
-    [[nodiscard]] double tick_with_clock(steady_clock::time_point tick_timepoint) noexcept {
-        if (m_paused) { m_last_delta = std::chrono::nanoseconds(0); m_last_steps = 0; m_last = tick_timepoint; return alpha(); }
-        if (m_last.time_since_epoch().count() == 0) m_last = tick_timepoint; // first call safety
+    [[nodiscard]] double tick_with_clock(time_point tick_timepoint) noexcept(k_nothrow) {
+        ISHAP_TRACE_SCOPE("ishap.tick");
+        if (m_control) (void)m_control->apply(*this);
+        if (m_paused) { clear_last_tick(); m_last = tick_timepoint; m_has_last = true; return alpha(); }
+        if (!m_has_last) { m_last = tick_timepoint; m_has_last = true; } // first call safety
         auto raw = tick_timepoint - m_last;
         m_last = tick_timepoint;
-        return advance(std::chrono::duration_cast<std::chrono::nanoseconds>(raw));
+        return advance(std::chrono::duration_cast<std::chrono::nanoseconds>(raw), tick_timepoint);
     }
 
 	/**
@@ -251,48 +739,244 @@ private:
     * @details This is the core logic that handles clamping, time scaling, stepping, and accumulator management.
     * It is called by both tick_with_clock() and push_time().
 	* @param raw_elapsed The elapsed time since the last call, as a std::chrono::nanoseconds duration.
+	* @param timestamp The tick time point for telemetry; a default-constructed value reads the clock if needed.
 	* @return The interpolation alpha value in the range [0, 1), representing the
 	*         fraction of the next fixed timestep that has been accumulated.
 	*/
-    [[nodiscard]] double advance(std::chrono::nanoseconds raw_elapsed) noexcept {
-        if (m_paused) { m_last_delta = std::chrono::nanoseconds(0); m_last_steps = 0; return alpha(); }
+    [[nodiscard]] double advance(std::chrono::nanoseconds raw_elapsed, time_point timestamp) noexcept(k_nothrow) {
+        ISHAP_TRACE_SCOPE("ishap.advance");
+        if (m_paused) { clear_last_tick(); return alpha(); }
+        const std::chrono::nanoseconds elapsed = m_delta_filter ? m_delta_filter->filter(raw_elapsed) : raw_elapsed;
+        if (m_recorder) m_recorder->record_elapsed(elapsed);
         m_step_error_caught = false;
         m_last_delta = raw_elapsed;
 
-		// Clamp [Safety]
-        std::chrono::nanoseconds dt = raw_elapsed;
-        if (dt > m_config.safety_max_delta) dt = m_config.safety_max_delta;
-
-		// Time scale
-        if (m_config.time_scale != 1.0) {
-			    dt = std::chrono::duration_cast<std::chrono::nanoseconds>(dt * m_config.time_scale);
-        }
-
+		// Clamp [Safety] + Time scale
+        const std::chrono::nanoseconds dt = detail::scaled_delta(elapsed, m_config);
         m_accumulator += dt;
 
-        // Step Loop [with Safety Cap]
+        // Step Loop [with Safety Cap, or the smooth catch-up share]
+        const size_t limit = step_limit(dt);
         size_t steps = 0;
-        while (m_accumulator >= m_config.step && steps < m_config.safety_max_substeps) {
-            try {
-                if (m_on_update_function) m_on_update_function(m_config.step);
-            } catch (...) {
-                m_step_error_caught = true;
-                if (m_on_error_function) m_on_error_function();
-                // Swallow exceptions from user code to maintain noexcept guarantee
+        DeferredWorkQueue::time_point work_start{};
+        if (m_on_batch_function) {
+            // Batch path: same step count as the loop below, delivered in one call
+            const auto pending = static_cast<size_t>(m_accumulator / m_config.step);
+            steps = pending < limit ? pending : limit;
+            if (steps > 0) {
+                if (m_deferred_work) work_start = DeferredWorkQueue::clock_type::now();
+                const StepCommit commit{*this, steps, true};
+                timed_call(steps, m_on_batch_function, steps, m_config.step);
+            }
+        } else {
+            while (m_accumulator >= m_config.step && steps < limit) {
+                if (m_deferred_work) work_start = DeferredWorkQueue::clock_type::now();
+                {
+                    const StepCommit commit{*this, 1, true};
+                    timed_call(1, m_on_update_function, m_config.step);
+                }
+                ++steps;
             }
-            m_accumulator -= m_config.step;
-            ++steps;
         }
         m_last_steps = steps;
+        m_last_dropped_steps = static_cast<size_t>(m_accumulator / m_config.step);
+
+        // Deferred work: headroom after the last step, only when no step is still due
+        if (m_deferred_work && steps > 0 && m_last_dropped_steps == 0) {
+            run_deferred_work(work_start, m_on_batch_function ? steps : 1);
+        }
 
 		// Trim excess accumulator [With Safety Cap]
-		const std::chrono::nanoseconds max_acc = m_config.step * m_config.safety_max_accumulator_overflow;
-		if (m_accumulator > max_acc) { m_accumulator = max_acc; }
+        const std::chrono::nanoseconds untrimmed = m_accumulator;
+		detail::trim_accumulator_for_catch_up(m_accumulator, m_config);
+        m_last_trimmed = untrimmed - m_accumulator;
+        m_last_deferred_steps = static_cast<size_t>(m_accumulator / m_config.step);
+
+        ISHAP_TRACE_COUNTER("ishap.steps", steps);
+        ISHAP_TRACE_COUNTER("ishap.accumulator_ns", m_accumulator.count());
+        if (m_last_trimmed.count() > 0) {
+            ISHAP_TRACE_INSTANT("ishap.trim");
+            ISHAP_TRACE_COUNTER("ishap.trimmed_ns", m_last_trimmed.count());
+        }
+
+        if (m_telemetry) {
+            if (timestamp.time_since_epoch().count() == 0) timestamp = clock_type::now();
+            TelemetryRecord record;
+            record.timestamp        = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch());
+            record.raw_delta        = raw_elapsed;
+            record.clamped_delta    = dt;
+            record.steps            = steps;
+            record.dropped_steps    = m_last_dropped_steps;
+            record.deferred_steps   = m_last_deferred_steps;
+            record.trimmed          = m_last_trimmed;
+            (void)m_telemetry->try_push(record);
+        }
+
+        // Adaptive rate: takes effect from the next tick. Smooth catch-up carries debt on purpose, so only
+        // the steps thrown away count as overload there
+        if (m_rate_controller) {
+            const size_t overload = m_config.catch_up == CatchUpPolicy::smooth
+                                  ? m_last_dropped_steps - m_last_deferred_steps : m_last_dropped_steps;
+            const std::chrono::nanoseconds s = m_rate_controller->observe(
+                steps, overload, m_last_trimmed, m_config.safety_max_substeps);
+            if (s.count() > 0) set_step(s);
+        }
 		
         // Return (trimmed) alpha for interpolation into next step
         return alpha();
     }
 
+	/**
+	* @brief Commits the bookkeeping of a step (or batch) call when it leaves scope, also while an exception
+	*        unwinds, so under PropagateErrors the step that threw counts as run.
+	* @details During the call step_index() is still the index of the step being simulated.
+	*/
+    struct StepCommit {
+        BasicFixedTimestepRunner&   self;
+        size_t                      steps;
+		/// @brief Whether the steps' time is taken from the accumulator (false for fast-forward / resimulation)
+        bool                        consume;
+        ~StepCommit() {
+            if (consume) self.m_accumulator -= self.m_config.step * static_cast<std::chrono::nanoseconds::rep>(steps);
+            self.m_step_index += steps;
+        }
+    };
+
+	/**
+	* @brief Runs steps back-to-back in chunks, reporting progress between chunks.
+	* @param steps The number of steps to run.
+	* @param progress The progress callable (see fast_forward()).
+	* @return The number of steps executed.
+	*/
+    template <class Progress>
+    size_t run_steps(size_t steps, Progress& progress) noexcept(k_nothrow) {
+        m_step_error_caught = false;
+        size_t done = 0;
+        while (done < steps) {
+            const size_t chunk = (steps - done) < k_fast_forward_chunk ? (steps - done) : k_fast_forward_chunk;
+            if (m_on_batch_function) {
+                const StepCommit commit{*this, chunk, false};
+                timed_call(chunk, m_on_batch_function, chunk, m_config.step);
+            } else {
+                for (size_t i = 0; i < chunk; ++i) {
+                    const StepCommit commit{*this, 1, false};
+                    timed_call(1, m_on_update_function, m_config.step);
+                }
+            }
+            done += chunk;
+            if constexpr (std::is_void_v<std::invoke_result_t<Progress&, size_t, size_t>>) {
+                progress(done, steps);
+            } else {
+                if (!progress(done, steps)) break;
+            }
+        }
+        return done;
+    }
+
+	/**
+	* @brief Get the maximum number of steps this tick may run.
+	* @details Drop: safety_max_substeps. Smooth: the usual steps per frame (a moving average of what each
+	*          frame's delta covers) plus a catch-up share of the debt, fixed when the debt appears so that it
+	*          is repaid in about catch_up_frames frames, never more than catch_up_max_extra_steps per frame.
+	* @param dt This tick's clamped, scaled delta; the accumulator already includes it.
+	*/
+    [[nodiscard]] size_t step_limit(std::chrono::nanoseconds dt) noexcept {
+        const size_t cap = m_config.safety_max_substeps;
+        if (m_config.catch_up != CatchUpPolicy::smooth) return cap;
+
+        const double covered = static_cast<double>(dt.count()) / static_cast<double>(m_config.step.count());
+        if (m_frame_steps_avg < 0.0) m_frame_steps_avg = covered < static_cast<double>(cap) ? covered : static_cast<double>(cap);
+        const auto rounded = static_cast<size_t>(m_frame_steps_avg + 0.5);
+        const size_t usual = rounded > 0 ? rounded : size_t{1};
+        // A hitch frame counts as at most twice the usual frame, so it is repaid as debt instead of raising the baseline
+        const double sample = covered < static_cast<double>(usual * 2) ? covered : static_cast<double>(usual * 2);
+        m_frame_steps_avg += (sample - m_frame_steps_avg) * k_catch_up_frame_weight;
+
+        const auto pending = static_cast<size_t>(m_accumulator / m_config.step);
+        const size_t debt = pending > usual ? pending - usual : 0;
+        if (debt == 0) {
+            m_catch_up_rate = 0;
+        } else {
+            const size_t frames = m_config.catch_up_frames > 0 ? m_config.catch_up_frames : size_t{1};
+            const size_t share = (debt + frames - 1) / frames;
+            if (share > m_catch_up_rate) m_catch_up_rate = share;
+            if (m_catch_up_rate > m_config.catch_up_max_extra_steps) m_catch_up_rate = m_config.catch_up_max_extra_steps;
+        }
+        const size_t limit = usual + m_catch_up_rate;
+        return limit < cap ? limit : cap;
+    }
+
+	/**
+	* @brief Runs deferred work in what is left of the wall-time budget of the last step (or batch).
+	* @param step_start When the last step (or batch) started.
+	* @param steps The number of steps the budget covers.
+	*/
+    void run_deferred_work(DeferredWorkQueue::time_point step_start, size_t steps) noexcept {
+        std::chrono::nanoseconds wall = m_config.step * static_cast<std::chrono::nanoseconds::rep>(steps);
+        if (m_config.time_scale > 0.0 && m_config.time_scale != 1.0) {
+            wall = std::chrono::duration_cast<std::chrono::nanoseconds>(wall / m_config.time_scale);
+        }
+        ISHAP_TRACE_SCOPE("ishap.deferred_work");
+        (void)m_deferred_work->run_after_step(step_start, wall);
+    }
+
+    /// @brief Clears the per-tick telemetry for a tick that did not advance (paused).
+    void clear_last_tick() noexcept {
+        m_last_delta            = std::chrono::nanoseconds(0);
+        m_last_steps            = 0;
+        m_last_dropped_steps    = 0;
+        m_last_trimmed          = std::chrono::nanoseconds(0);
+        m_last_deferred_steps   = 0;
+    }
+
+	/**
+	* @brief Invokes a user callable through guarded_call(), timing it when step timing is attached.
+	* @details The overrun function of attached step timing runs through guarded_call() as well.
+	* @param steps Number of steps the call covers, used to derive a per-step cost.
+	* @param fn The user callable (step or batch function).
+	* @param args Arguments forwarded to the callable.
+	*/
+    template <class F, class... Args>
+    void timed_call([[maybe_unused]] size_t steps, F& fn, Args&&... args) noexcept(k_nothrow) {
+        ISHAP_TRACE_SCOPE("ishap.step");
+#if ISHAP_ENABLE_STEP_TIMING
+        if (m_step_timing) {
+            const auto start = clock_type::now();
+            guarded_call(fn, std::forward<Args>(args)...);
+            const auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start);
+            const auto per_step = cost / static_cast<std::chrono::nanoseconds::rep>(steps);
+            if (m_step_timing->record_cost(per_step, m_config.step)) {
+                guarded_call(m_step_timing->overrun_function(), per_step, m_step_timing->budget(m_config.step));
+            }
+            return;
+        }
+#endif
+        guarded_call(fn, std::forward<Args>(args)...);
+    }
+
+	/**
+	* @brief Invokes a user callable under the error policy.
+	* @details Catching policies set m_step_error_caught and call the error function; the others make a bare call.
+	* @param fn The user callable (step or batch function).
+	* @param args Arguments forwarded to the callable.
+	*/
+    template <class F, class... Args>
+    void guarded_call(F& fn, Args&&... args) noexcept(k_nothrow) {
+#if ISHAP_HAS_EXCEPTIONS
+        if constexpr (detail::catches_errors_v<ErrorPolicy, F&, Args&&...>) {
+            try {
+                detail::invoke_if_set(fn, std::forward<Args>(args)...);
+            } catch (...) {
+                m_step_error_caught = true;
+                if (detail::is_callable_set(m_on_error_function)) m_on_error_function();
+                // Swallow exceptions from user code to maintain noexcept guarantee
+            }
+            return;
+        }
+#endif
+        detail::invoke_if_set(fn, std::forward<Args>(args)...);
+    }
+
 private:
 	/// @brief Update / Step function to call each fixed step
     OnStepFunction              	m_on_update_function{};
@@ -300,22 +984,81 @@ private:
     Config                        	m_config{};
 
 	/// @brief Last time point recorded (for tick())
-    steady_clock::time_point      	m_last{};
+    time_point                    	m_last{};
 	/// @brief Accumulator for leftover time between steps
     std::chrono::nanoseconds      	m_accumulator{0};
 	/// @brief Paused state
     bool                          	m_paused{false};
+	/// @brief Whether m_last holds a real reading (false until reset(true) or the first tick())
+    bool                          	m_has_last{false};
+
+	/// @brief Index of the next step to run (monotonic except for rollback_to())
+    uint64_t                        m_step_index{0};
 
     /// @brief Step Error Caught
     bool                            m_step_error_caught{false};
     /// @brief Optional error callback for step errors
     OnErrorFunction                 m_on_error_function{};
+    /// @brief Optional batch step callback (replaces per-step calls when set)
+    OnBatchStepFunction             m_on_batch_function{};
 
 	// --- Telemetry ---
 	/// @brief Frame delta tracking (pre-clamp, pre-scale) for telemetry
     std::chrono::nanoseconds      	m_last_delta{0};
 	/// @brief Number of steps taken in last tick for telemetry
     size_t                        	m_last_steps{0};
+	/// @brief Number of due steps left unexecuted by the substep cap in last tick
+    size_t                        	m_last_dropped_steps{0};
+	/// @brief Time discarded by the accumulator trim in last tick
+    std::chrono::nanoseconds      	m_last_trimmed{0};
+	/// @brief Whole steps of debt kept in the accumulator after the trim in last tick
+    size_t                        	m_last_deferred_steps{0};
+
+	// --- Smooth catch-up ---
+	/// @brief Moving average of the steps each frame's delta covers (negative until the first tick)
+    double                        	m_frame_steps_avg{-1.0};
+	/// @brief Extra steps per frame for the debt being repaid
+    size_t                        	m_catch_up_rate{0};
+	/// @brief Optional telemetry ring (not owned)
+    TelemetryRing*                	m_telemetry{nullptr};
+	/// @brief Optional step-start lateness histogram (not owned)
+    DeadlineHistogram*            	m_deadline_histogram{nullptr};
+	/// @brief Optional input recorder (not owned)
+    Recorder*                     	m_recorder{nullptr};
+	/// @brief Optional adaptive rate controller (not owned)
+    AdaptiveRateController*       	m_rate_controller{nullptr};
+	/// @brief Optional delta filter (not owned)
+    DeltaFilter*                  	m_delta_filter{nullptr};
+	/// @brief Optional deferred work queue (not owned)
+    DeferredWorkQueue*            	m_deferred_work{nullptr};
+	/// @brief Optional cross-thread control channel (not owned)
+    ControlChannel*               	m_control{nullptr};
+#if ISHAP_ENABLE_STEP_TIMING
+	/// @brief Optional step cost statistics (not owned)
+    StepTimingStats*              	m_step_timing{nullptr};
+#endif
 };
 
+/// @brief Type-erased runner; callables are runtime-swappable std::function targets
+using FixedTimestepRunner = BasicFixedTimestepRunner<
+    std::function<void(std::chrono::nanoseconds)>,
+    std::function<void()>
+>;
+
+/// @brief Type-erased runner storing its callables in place (no heap use); captures beyond Capacity bytes do not compile
+template <size_t Capacity = k_default_inplace_capacity, class Clock = std::chrono::steady_clock>
+using InplaceFixedTimestepRunner = BasicFixedTimestepRunner<
+    InplaceFunction<void(std::chrono::nanoseconds), Capacity>,
+    InplaceFunction<void(), Capacity>,
+    Clock
+>;
+
+/// @brief Type-erased runner reading a custom clock (e.g. TscClock, ManualClock)
+template <class Clock>
+using ClockedFixedTimestepRunner = BasicFixedTimestepRunner<
+    std::function<void(std::chrono::nanoseconds)>,
+    std::function<void()>,
+    Clock
+>;
+
 } // namespace ishap::timestep
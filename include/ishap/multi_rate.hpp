@@ -0,0 +1,294 @@
+// multi_rate.hpp — several fixed-step channels driven by one clock read
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - One steady_clock read per tick for all channels (physics, AI, netcode …)
+// - Steps of all channels are interleaved in timestamp order within a frame,
+//   so a low-rate channel observes the state the high-rate channel had at
+//   that moment rather than the end-of-frame state
+// - Each channel keeps its own Config (step, clamps, substep cap, time scale)
+//   and reuses the runner's clamp and trim rules
+// - Step errors follow the ErrorPolicy of error_policy.hpp, as in the runner;
+//   a caught error calls the error function with the channel index
+//
+// Usage
+//   ishap::timestep::MultiRateRunner<3> runner;
+//   runner.set_channel(0, physics_step, {.step = ishap::timestep::k_step_240hz});
+//   runner.set_channel(1, ai_step,      {.step = 33'333'333ns});
+//   runner.set_channel(2, net_step,     {.step = 50ms});
+//   for (;;) {
+//       runner.tick();
+//       // render(interpolate(runner.alpha(0)));
+//   }
+//
+#pragma once
+
+#include "ishap.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace ishap::timestep {
+
+/**
+* @brief Runs N fixed-step channels from a single time source
+* @tparam N Number of channels.
+* @tparam StepFn Callable invoked as void(std::chrono::nanoseconds) for each step of a channel.
+* @tparam ErrorPolicy How exceptions from step functions are handled (see error_policy.hpp).
+* @details Channels without a step function are inactive: they neither accumulate time
+*          nor contribute to next_deadline(). When steps of two channels fall on the same
+*          instant, the lower channel index runs first.
+*/
+template <size_t N, class StepFn = std::function<void(std::chrono::nanoseconds)>, class ErrorPolicy = AutoErrorPolicy>
+class MultiRateRunner {
+    static_assert(N > 0, "MultiRateRunner needs at least one channel");
+public:
+    using OnStepFunction = StepFn;
+    using OnErrorFunction = std::function<void(size_t)>;
+    using steady_clock = std::chrono::steady_clock;
+    using error_policy = ErrorPolicy;
+
+	/// @brief Whether tick() and push_time() are noexcept
+    static constexpr bool k_nothrow = !detail::propagates_errors_v<ErrorPolicy>;
+
+    MultiRateRunner() { reset(true); }
+
+    /**
+	* @brief Resets the accumulators and telemetry of all channels.
+	* @param start_now If true, sets the last time point to the current time. Default is true.
+	*/
+    void reset(bool start_now = true) noexcept {
+        for (auto& c : m_channels) { c.accumulator = std::chrono::nanoseconds(0); c.last_steps = 0; }
+        m_last_delta            = std::chrono::nanoseconds(0);
+        m_paused                = false;
+        if (start_now) m_last   = steady_clock::now();
+    }
+
+    /**
+	* @brief Configures a channel.
+	* @param index Channel index in [0, N).
+	* @param fn The step function of the channel.
+	* @param config The configuration of the channel, validated as by set_config(); ignored values keep the
+	*        Config defaults.
+	*/
+    void set_channel(size_t index, OnStepFunction fn, const Config& config = {}) {
+        if (index >= N) return;
+        m_channels[index].fn            = std::move(fn);
+        m_channels[index].config        = Config{};
+        set_config(index, config);
+        m_channels[index].accumulator   = std::chrono::nanoseconds(0);
+        m_channels[index].last_steps    = 0;
+    }
+
+    /// @brief Replaces the step function of a channel, keeping its configuration and accumulator.
+    void set_step_function(size_t index, OnStepFunction fn) {
+        if (index < N) m_channels[index].fn = std::move(fn);
+    }
+
+    /**
+	* @brief Replaces the configuration of a channel, keeping its accumulator.
+	* @details Non-positive step or max delta values and a zero substep cap are ignored, as in the runner setters.
+	*          The catch-up policy is not used: channels always drop (CatchUpPolicy::drop).
+	*/
+    void set_config(size_t index, const Config& config) noexcept {
+        if (index >= N) return;
+        Config& c = m_channels[index].config;
+        if (config.step.count() > 0)                c.step = config.step;
+        if (config.safety_max_delta.count() > 0)    c.safety_max_delta = config.safety_max_delta;
+        c.safety_max_substeps               = (config.safety_max_substeps > 0 ? config.safety_max_substeps : size_t{1});
+        c.safety_max_accumulator_overflow   = config.safety_max_accumulator_overflow;
+        c.time_scale                        = (config.time_scale < 0.0 ? 0.0 : config.time_scale);
+    }
+
+    /// @brief Get the configuration of a channel.
+    [[nodiscard]] const Config& config(size_t index) const noexcept { return m_channels[index].config; }
+
+    /// @brief Returns whether a channel has a step function (and is therefore active).
+    [[nodiscard]] bool has_step_function(size_t index) const noexcept {
+        return index < N && detail::is_callable_set(m_channels[index].fn);
+    }
+
+    /// @brief Sets the error function, called with the channel index when a step throws.
+    void set_error_function(OnErrorFunction fn) { m_on_error_function = std::move(fn); }
+
+    /**
+	* @brief Advances all channels using a single read of the steady clock.
+	* @return The total number of steps executed across all channels.
+	*/
+    size_t tick() noexcept(k_nothrow) { return tick_with_clock(steady_clock::now()); }
+
+    /**
+	* @brief Advances all channels using an externally provided elapsed time.
+	* @param elapsed The elapsed time since the last call.
+	* @return The total number of steps executed across all channels.
+	*/
+    size_t push_time(std::chrono::nanoseconds elapsed) noexcept(k_nothrow) { return advance(elapsed); }
+
+    /**
+	* @brief Returns the earliest point in time at which any active channel has a step due.
+	* @return The deadline, or steady_clock::time_point::max() when paused or no channel can advance.
+	*/
+    [[nodiscard]] steady_clock::time_point next_deadline() const noexcept {
+        auto deadline = steady_clock::time_point::max();
+        if (m_paused) return deadline;
+        for (const auto& c : m_channels) {
+            if (!detail::is_callable_set(c.fn) || c.config.time_scale <= 0.0) continue;
+            const auto remaining = c.config.step - c.accumulator;
+            auto wall = std::chrono::nanoseconds(0);
+            if (remaining.count() > 0) {
+                wall = c.config.time_scale == 1.0 ? remaining
+                     : std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::duration<double, std::nano>(remaining.count() / c.config.time_scale));
+            }
+            const auto t = m_last + wall;
+            if (t < deadline) deadline = t;
+        }
+        return deadline;
+    }
+
+    /// @brief Pauses or unpauses all channels.
+    void   pause(bool p = true) noexcept    { m_paused = p; }
+    /// @brief Returns whether the runner is currently paused.
+    [[nodiscard]] bool paused() const noexcept { return m_paused; }
+    /// @brief Unpauses the runner. Alias for pause(false).
+    void   resume() noexcept                { m_paused = false; }
+
+    /// @brief Get the accumulator of a channel.
+    [[nodiscard]] std::chrono::nanoseconds accumulator(size_t index) const noexcept { return m_channels[index].accumulator; }
+    /// @brief Get the number of steps a channel executed in the last tick.
+    [[nodiscard]] size_t last_steps(size_t index) const noexcept { return m_channels[index].last_steps; }
+    /// @brief Get the interpolation factor of a channel.
+    [[nodiscard]] double alpha(size_t index) const noexcept {
+        const auto& c = m_channels[index];
+        return static_cast<double>(c.accumulator.count()) / static_cast<double>(c.config.step.count());
+    }
+    /// @brief Get the last frame's raw delta time before clamping and time scaling.
+    [[nodiscard]] std::chrono::nanoseconds last_delta() const noexcept { return m_last_delta; }
+    /// @brief Returns whether a step error was caught in user code during the last tick (always false when the policy does not catch).
+    [[nodiscard]] bool step_error_caught() const noexcept { return m_step_error_caught; }
+
+    /// @brief Number of channels.
+    [[nodiscard]] static constexpr size_t size() noexcept { return N; }
+
+private:
+    /// @brief Per-channel state
+    struct Channel {
+        OnStepFunction              fn{};
+        Config                      config{};
+        std::chrono::nanoseconds    accumulator{0};
+        size_t                      last_steps{0};
+    };
+
+	/// @brief Takes a channel step's time from its accumulator and counts it, also when the step function throws
+    struct StepCommit {
+        Channel&                    channel;
+        ~StepCommit() {
+            channel.accumulator -= channel.config.step;
+            ++channel.last_steps;
+        }
+    };
+
+    /// @brief Advances all channels using a provided time point from a steady clock.
+    size_t tick_with_clock(steady_clock::time_point tick_timepoint) noexcept(k_nothrow) {
+        if (m_paused) { m_last_delta = std::chrono::nanoseconds(0); m_last = tick_timepoint; clear_last_steps(); return 0; }
+        if (m_last.time_since_epoch().count() == 0) m_last = tick_timepoint; // first call safety
+        auto raw = tick_timepoint - m_last;
+        m_last = tick_timepoint;
+        return advance(std::chrono::duration_cast<std::chrono::nanoseconds>(raw));
+    }
+
+	/**
+	* @brief Advances all channels by a specified elapsed time.
+	* @details Each channel accumulates its own clamped and scaled delta. Pending steps are then
+	*          executed in order of the frame-relative instant at which each became due, so steps
+	*          of different channels interleave as they would on a continuous timeline.
+	*/
+    size_t advance(std::chrono::nanoseconds raw_elapsed) noexcept(k_nothrow) {
+        if (m_paused) { m_last_delta = std::chrono::nanoseconds(0); clear_last_steps(); return 0; }
+        m_step_error_caught = false;
+        m_last_delta = raw_elapsed;
+
+        // Accumulate; remember where each channel started so due instants can be ordered
+        std::array<std::chrono::nanoseconds, N> start{};
+        std::array<double, N> inv_dt{};
+        for (size_t i = 0; i < N; ++i) {
+            Channel& c = m_channels[i];
+            c.last_steps = 0;
+            if (!detail::is_callable_set(c.fn)) continue;
+            const auto dt = detail::scaled_delta(raw_elapsed, c.config);
+            start[i] = c.accumulator;
+            inv_dt[i] = dt.count() > 0 ? 1.0 / static_cast<double>(dt.count()) : 0.0;
+            c.accumulator += dt;
+        }
+
+        // Interleaved step loop [with per-channel Safety Cap]
+        size_t total = 0;
+        for (;;) {
+            size_t next = N;
+            double next_due = std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < N; ++i) {
+                const Channel& c = m_channels[i];
+                if (c.accumulator < c.config.step || c.last_steps >= c.config.safety_max_substeps) continue;
+                if (!detail::is_callable_set(c.fn)) continue;
+                // Fraction of this frame's delta at which step (last_steps + 1) became due
+                const auto due_at = c.config.step * static_cast<std::chrono::nanoseconds::rep>(c.last_steps + 1) - start[i];
+                const double due = static_cast<double>(due_at.count()) * inv_dt[i];
+                if (due < next_due) { next_due = due; next = i; }
+            }
+            if (next == N) break;
+
+            {
+                const StepCommit commit{m_channels[next]};
+                guarded_call(next);
+            }
+            ++total;
+        }
+
+		// Trim excess accumulators [With Safety Cap]
+        for (auto& c : m_channels) detail::trim_accumulator(c.accumulator, c.config);
+        return total;
+    }
+
+	/// @brief Runs one step of a channel under the error policy.
+    void guarded_call(size_t index) noexcept(k_nothrow) {
+        Channel& c = m_channels[index];
+#if ISHAP_HAS_EXCEPTIONS
+        if constexpr (detail::catches_errors_v<ErrorPolicy, OnStepFunction&, std::chrono::nanoseconds>) {
+            try {
+                detail::invoke_if_set(c.fn, c.config.step);
+            } catch (...) {
+                m_step_error_caught = true;
+                if (m_on_error_function) m_on_error_function(index);
+                // Swallow exceptions from user code to maintain noexcept guarantee
+            }
+            return;
+        }
+#endif
+        detail::invoke_if_set(c.fn, c.config.step);
+    }
+
+    /// @brief Clears per-channel step telemetry.
+    void clear_last_steps() noexcept { for (auto& c : m_channels) c.last_steps = 0; }
+
+private:
+	/// @brief Channel states
+    std::array<Channel, N>          m_channels{};
+	/// @brief Last time point recorded (for tick())
+    steady_clock::time_point        m_last{};
+	/// @brief Paused state
+    bool                            m_paused{false};
+    /// @brief Step Error Caught
+    bool                            m_step_error_caught{false};
+    /// @brief Optional error callback for step errors, called with the channel index
+    OnErrorFunction                 m_on_error_function{};
+
+	// --- Telemetry ---
+	/// @brief Frame delta tracking (pre-clamp, pre-scale) for telemetry
+    std::chrono::nanoseconds        m_last_delta{0};
+};
+
+} // namespace ishap::timestep
@@ -0,0 +1,250 @@
+// parallel_dispatch.hpp — work-stealing execution of a RunnerPool's due steps
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - After RunnerPool::tick() every session knows how many steps it is due;
+//   the sessions are independent, so their steps can run on all cores
+// - A session is the unit of work: all of its due steps run in order on one
+//   worker, so per-session step order is preserved
+// - Each worker starts on its own contiguous slice of the due sessions and
+//   steals from other slices once it runs dry; claiming is a single atomic
+//   fetch_add, no locks on the hot path
+// - dispatch() returns only when every due step has run: a frame barrier
+//   before interpolation and rendering
+// - The calling thread participates as worker 0
+//
+// Usage
+//   ishap::timestep::ParallelStepDispatcher dispatcher;   // hardware_concurrency() workers
+//   for (;;) {
+//       pool.tick();
+//       dispatcher.dispatch(pool, [&](size_t session, size_t steps, std::chrono::nanoseconds dt){
+//           for (size_t s = 0; s < steps; ++s) sessions[session].step(dt);
+//       });
+//       // barrier passed: interpolate + render
+//   }
+//
+#pragma once
+
+#include "runner_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ishap::timestep {
+
+/// @brief Per-worker figures of the last dispatch()
+struct WorkerStats {
+	/// @brief Sessions executed by this worker
+    size_t                      sessions        = 0;
+	/// @brief Steps executed by this worker
+    size_t                      steps           = 0;
+	/// @brief Sessions taken from another worker's slice
+    size_t                      steals          = 0;
+	/// @brief Time spent executing sessions
+    std::chrono::nanoseconds    busy            {0};
+	/// @brief busy divided by the wall time of the whole dispatch, in [0, 1]
+    double                      utilization     = 0.0;
+};
+
+/**
+* @brief Runs the due steps of many independent sessions on a fixed set of worker threads
+* @details One dispatch() at a time, from one thread. The session callable runs concurrently for
+*          different sessions and must not throw; exceptions are caught, counted and swallowed.
+*/
+class ParallelStepDispatcher {
+public:
+    using steady_clock = std::chrono::steady_clock;
+
+	/**
+	* @brief Starts the worker threads.
+	* @param workers Total number of workers including the calling thread. 0 selects hardware_concurrency().
+	*/
+    explicit ParallelStepDispatcher(size_t workers = 0) {
+        if (workers == 0) workers = std::thread::hardware_concurrency();
+        if (workers == 0) workers = 1;
+        m_workers = std::make_unique<Worker[]>(workers);
+        m_worker_count = workers;
+        m_threads.reserve(workers - 1);
+        for (size_t w = 1; w < workers; ++w) m_threads.emplace_back([this, w]{ worker_main(w); });
+    }
+
+    ParallelStepDispatcher(const ParallelStepDispatcher&)            = delete;
+    ParallelStepDispatcher& operator=(const ParallelStepDispatcher&) = delete;
+
+    ~ParallelStepDispatcher() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start_cv.notify_all();
+        for (auto& t : m_threads) t.join();
+    }
+
+	/**
+	* @brief Executes every session with due steps in the pool and waits for all of them.
+	* @param pool The pool, already advanced for this frame.
+	* @param fn Callable invoked as fn(size_t session, size_t steps, std::chrono::nanoseconds step).
+	* @return The number of steps executed.
+	*/
+    template <class Fn>
+    size_t dispatch(const RunnerPool& pool, Fn&& fn) {
+        m_tasks.clear();
+        const size_t* due = pool.due_data();
+        for (size_t i = 0, n = pool.size(); i < n; ++i) {
+            if (due[i] != 0) m_tasks.push_back(i);
+        }
+
+        using F = std::remove_reference_t<Fn>;
+        m_pool      = &pool;
+        m_context   = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+        m_invoke    = [](void* ctx, size_t session, size_t steps, std::chrono::nanoseconds step) {
+            (*static_cast<F*>(ctx))(session, steps, step);
+        };
+        return run_frame();
+    }
+
+	/// @brief Get the number of workers, including the calling thread.
+    [[nodiscard]] size_t worker_count() const noexcept { return m_worker_count; }
+	/// @brief Get a worker's figures for the last dispatch().
+    [[nodiscard]] const WorkerStats& worker_stats(size_t worker) const noexcept { return m_workers[worker].stats; }
+	/// @brief Get the wall time of the last dispatch().
+    [[nodiscard]] std::chrono::nanoseconds last_dispatch_time() const noexcept { return m_last_dispatch_time; }
+	/// @brief Returns whether a session callable threw during the last dispatch().
+    [[nodiscard]] bool step_error_caught() const noexcept { return m_errors.load(std::memory_order_relaxed) != 0; }
+
+private:
+	/// @brief A worker's slice of the task list plus its statistics, on its own cache line
+    struct alignas(k_cache_line_size) Worker {
+        std::atomic<size_t>         next{0};
+        size_t                      end{0};
+        WorkerStats                 stats{};
+    };
+
+    size_t run_frame() {
+        const auto start = steady_clock::now();
+        const size_t tasks = m_tasks.size();
+        for (size_t w = 0; w < m_worker_count; ++w) {
+            m_workers[w].next.store(tasks * w / m_worker_count, std::memory_order_relaxed);
+            m_workers[w].end = tasks * (w + 1) / m_worker_count;
+            m_workers[w].stats = WorkerStats{};
+        }
+        m_errors.store(0, std::memory_order_relaxed);
+
+        if (m_worker_count > 1 && tasks > 1) {
+            m_pending.store(m_worker_count - 1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_generation;
+            }
+            m_start_cv.notify_all();
+            work(0);
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done_cv.wait(lock, [this]{ return m_pending.load(std::memory_order_acquire) == 0; });
+        } else {
+            // Nothing worth waking the pool for: run everything on the caller
+            m_workers[0].end = tasks;
+            for (size_t w = 1; w < m_worker_count; ++w) m_workers[w].end = m_workers[w].next.load(std::memory_order_relaxed);
+            work(0);
+        }
+
+        m_last_dispatch_time = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start);
+        size_t steps = 0;
+        for (size_t w = 0; w < m_worker_count; ++w) {
+            WorkerStats& s = m_workers[w].stats;
+            s.utilization = m_last_dispatch_time.count() > 0
+                ? static_cast<double>(s.busy.count()) / static_cast<double>(m_last_dispatch_time.count()) : 0.0;
+            steps += s.steps;
+        }
+        return steps;
+    }
+
+	/// @brief Drains the worker's own slice, then steals from the others until every slice is empty.
+    void work(size_t self) noexcept {
+        WorkerStats& stats = m_workers[self].stats;
+        const auto start = steady_clock::now();
+        size_t task = 0;
+        while (claim(self, task)) run_task(task, stats);
+        for (size_t k = 1; k < m_worker_count; ++k) {
+            const size_t victim = (self + k) % m_worker_count;
+            while (claim(victim, task)) { ++stats.steals; run_task(task, stats); }
+        }
+        stats.busy = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start);
+    }
+
+    bool claim(size_t worker, size_t& task) noexcept {
+        Worker& w = m_workers[worker];
+        if (w.next.load(std::memory_order_relaxed) >= w.end) return false;
+        const size_t i = w.next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= w.end) return false;
+        task = i;
+        return true;
+    }
+
+    void run_task(size_t task, WorkerStats& stats) noexcept {
+        const size_t session = m_tasks[task];
+        const size_t steps = m_pool->due(session);
+#if ISHAP_HAS_EXCEPTIONS
+        try {
+            m_invoke(m_context, session, steps, m_pool->step(session));
+        } catch (...) {
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+            // Swallow exceptions from user code to keep the worker alive
+        }
+#else
+        m_invoke(m_context, session, steps, m_pool->step(session));
+#endif
+        ++stats.sessions;
+        stats.steps += steps;
+    }
+
+    void worker_main(size_t self) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start_cv.wait(lock, [&]{ return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen = m_generation;
+            }
+            work(self);
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done_cv.notify_one();
+            }
+        }
+    }
+
+private:
+	/// @brief Per-worker slices and statistics
+    std::unique_ptr<Worker[]>       m_workers{};
+    size_t                          m_worker_count{0};
+    std::vector<std::thread>        m_threads{};
+
+	// --- Current frame ---
+	/// @brief Indices of sessions with due steps
+    std::vector<size_t>             m_tasks{};
+    const RunnerPool*               m_pool{nullptr};
+    void*                           m_context{nullptr};
+    void                            (*m_invoke)(void*, size_t, size_t, std::chrono::nanoseconds){nullptr};
+    std::atomic<size_t>             m_errors{0};
+    std::chrono::nanoseconds        m_last_dispatch_time{0};
+
+	// --- Frame start / barrier ---
+    std::mutex                      m_mutex{};
+    std::condition_variable         m_start_cv{};
+    std::condition_variable         m_done_cv{};
+    uint64_t                        m_generation{0};
+    std::atomic<size_t>             m_pending{0};
+    bool                            m_stop{false};
+};
+
+} // namespace ishap::timestep
@@ -0,0 +1,364 @@
+// pipeline.hpp — pipelined simulation / render overlap with a configurable frame depth
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - ThreadedRunner decouples the two threads completely; some titles instead
+//   want a fixed number of frames in flight, so the simulation of frame N+1
+//   overlaps the rendering of frame N at a known latency cost
+// - PipelinedRunner ticks a runner on its own thread and turns each tick's
+//   alpha into a render frame (the produce function interpolates into it);
+//   frames travel through a lock-free ring of depth + 1 slots, one of which
+//   the render thread holds between acquire() and release()
+// - Backpressure: when depth frames are ready (whether or not the renderer
+//   holds one), the simulation thread waits; the time it waited shows up in
+//   the next tick's delta and is caught up (or trimmed) as usual
+// - Either side spins briefly, then blocks on a condition variable, so a
+//   held frame or a slow simulation does not keep a core busy; the other
+//   side takes the mutex only when someone is actually blocked
+// - Per-stage timing (tick, produce, stall, render, starve, latency) is kept
+//   on the render thread from metadata carried by each frame, so tuning the
+//   depth per platform needs no shared counters
+// - set_thread_tuning() pins and prioritizes the simulation thread as it
+//   starts, as for ThreadedRunner
+//
+// Usage
+//   ishap::timestep::PipelinedRunner<RenderList> pipe{
+//       [&](std::chrono::nanoseconds dt){ history.step([&](const World& p, World& n){ simulate(p, n, dt); }); },
+//       [&](double alpha, RenderList& out){ build_render_list(history, alpha, out); },
+//       {.depth = 2}
+//   };
+//   pipe.start();
+//   while (const auto* f = pipe.acquire()) { draw(f->frame); present(); pipe.release(); }
+//
+#pragma once
+
+#include "ishap.hpp"
+#include "thread_tuning.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_default_pipeline_depth            = 1;
+    inline constexpr size_t
+        k_pipeline_max_depth                = 8;
+    inline constexpr size_t
+        k_pipeline_spin_iterations          = 256;      // relax iterations before blocking while waiting
+    inline constexpr double
+        k_pipeline_timing_weight            = 1.0 / 16.0; // weight of a new sample in the moving averages
+
+	/// @brief Configuration settings for the pipelined runner
+struct PipelineConfig {
+	/// @brief Frames the simulation may have ready ahead of the one being rendered, 1..k_pipeline_max_depth (default: 1)
+    size_t                      depth               = k_default_pipeline_depth;
+	/// @brief Runner configuration
+    Config                      runner              {};
+};
+
+/// @brief A render frame with the simulation-side metadata of the tick that produced it
+template <class Frame, class Clock = std::chrono::steady_clock>
+struct PipelineFrame {
+	/// @brief The user's render frame
+    Frame                           frame{};
+	/// @brief Sequence number, starting at 0
+    uint64_t                        sequence{0};
+	/// @brief The alpha returned by the tick
+    double                          alpha{0.0};
+	/// @brief Fixed steps run by the tick
+    size_t                          steps{0};
+	/// @brief When the frame was complete
+    typename Clock::time_point      produced{};
+	/// @brief Time spent in tick()
+    std::chrono::nanoseconds        tick_cost{0};
+	/// @brief Time spent in the produce function
+    std::chrono::nanoseconds        produce_cost{0};
+	/// @brief Time the simulation thread waited for a free slot before the tick
+    std::chrono::nanoseconds        stall{0};
+};
+
+/// @brief Last, moving average and maximum of one pipeline stage's duration
+struct PipelineStageTiming {
+    std::chrono::nanoseconds        last{0};
+    std::chrono::nanoseconds        avg{0};
+    std::chrono::nanoseconds        max{0};
+
+	/// @brief Adds a sample.
+    void add(std::chrono::nanoseconds d) noexcept {
+        last = d;
+        avg = avg.count() == 0 ? d : avg + std::chrono::duration_cast<std::chrono::nanoseconds>((d - avg) * k_pipeline_timing_weight);
+        if (d > max) max = d;
+    }
+};
+
+/// @brief Per-stage timing of a pipelined runner, maintained on the render thread
+struct PipelineStats {
+	/// @brief tick() on the simulation thread
+    PipelineStageTiming             tick{};
+	/// @brief Produce function on the simulation thread
+    PipelineStageTiming             produce{};
+	/// @brief Simulation thread blocked by a full pipeline (renderer lagging)
+    PipelineStageTiming             stall{};
+	/// @brief acquire() to release() on the render thread
+    PipelineStageTiming             render{};
+	/// @brief Render thread blocked in acquire() by an empty pipeline (simulation lagging)
+    PipelineStageTiming             starve{};
+	/// @brief Frame produced to frame acquired
+    PipelineStageTiming             latency{};
+	/// @brief Frames acquired
+    uint64_t                        frames{0};
+};
+
+/**
+* @brief Ticks a runner on a dedicated thread and feeds a bounded number of frames to one render thread
+* @tparam Frame The render frame type, filled by the produce function. Default-constructed once per slot.
+* @tparam StepFn Callable invoked as void(std::chrono::nanoseconds) for each fixed step, on the simulation thread.
+* @tparam ProduceFn Callable invoked as void(double alpha, Frame& out) after every tick, on the simulation thread.
+* @tparam Clock Steady clock driving the runner and the timings.
+* @details Configure through runner() before start() only; the runner is not thread-safe while running.
+*/
+template <class Frame,
+          class StepFn = std::function<void(std::chrono::nanoseconds)>,
+          class ProduceFn = std::function<void(double, Frame&)>,
+          class Clock = std::chrono::steady_clock>
+class PipelinedRunner {
+public:
+    using clock_type = Clock;
+    using time_point = typename clock_type::time_point;
+    using frame_type = PipelineFrame<Frame, Clock>;
+    using runner_type = BasicFixedTimestepRunner<StepFn, NoErrorFunction, Clock>;
+
+	/**
+	* @brief Constructs a stopped pipelined runner.
+	* @param step The fixed step function.
+	* @param produce The function turning a tick's alpha into a render frame.
+	* @param config The pipeline configuration; depth is clamped to 1..k_pipeline_max_depth.
+	*/
+    PipelinedRunner(StepFn step, ProduceFn produce, PipelineConfig config = {})
+        : m_produce(std::move(produce)), m_runner(std::move(step), std::move(config.runner)), m_depth(config.depth) {
+        if (m_depth < 1) m_depth = 1;
+        if (m_depth > k_pipeline_max_depth) m_depth = k_pipeline_max_depth;
+        m_slots.reset(new (std::nothrow) frame_type[m_depth + 1]);
+    }
+
+    PipelinedRunner(const PipelinedRunner&)            = delete;
+    PipelinedRunner& operator=(const PipelinedRunner&) = delete;
+
+	/// @brief Stops and joins the simulation thread.
+    ~PipelinedRunner() { stop(); }
+
+	/**
+	* @brief Starts the simulation thread with an empty pipeline. Time starts now.
+	* @return False if it is already running, the slots could not be allocated or the thread could not be created.
+	*/
+    bool start() noexcept {
+        if (m_thread.joinable() || !m_slots) return false;
+        m_stop.store(false, std::memory_order_relaxed);
+        m_tuning_applied.store(0, std::memory_order_relaxed);
+        m_tuning_error.store(0, std::memory_order_relaxed);
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        m_taken.store(0, std::memory_order_relaxed);
+        m_held = false;
+        m_runner.reset(true);
+#if ISHAP_HAS_EXCEPTIONS
+        try {
+            m_thread = std::thread([this]{ sim_main(); });
+        } catch (...) {
+            return false;
+        }
+#else
+        m_thread = std::thread([this]{ sim_main(); });
+#endif
+        return true;
+    }
+
+	/// @brief Requests the simulation thread to stop and joins it. A blocked acquire() returns nullptr.
+    void stop() noexcept {
+        m_stop.store(true);
+        { std::lock_guard<std::mutex> lock(m_wait_mutex); }
+        m_wake.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+	/// @brief Returns whether the simulation thread is running.
+    [[nodiscard]] bool running() const noexcept { return m_thread.joinable(); }
+
+	/**
+	* @brief Takes the oldest ready frame without waiting. Render thread only.
+	* @return The frame, valid until release(); nullptr if none is ready. Returns the held frame while one is held.
+	*/
+    [[nodiscard]] const frame_type* try_acquire() noexcept {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (m_held) return &m_slots[tail % (m_depth + 1)];
+        if (m_head.load(std::memory_order_acquire) == tail) return nullptr;
+        return take(tail);
+    }
+
+	/**
+	* @brief Takes the oldest ready frame, waiting for the simulation thread if none is. Render thread only.
+	* @return The frame, valid until release(); nullptr once stopped with nothing left.
+	*/
+    [[nodiscard]] const frame_type* acquire() noexcept {
+        if (const frame_type* f = try_acquire()) return f;
+        const time_point start = clock_type::now();
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        wait_until([&]{ return m_head.load() != tail; });
+        if (m_head.load() == tail) return nullptr;     // stopped with nothing left
+        m_stats.starve.add(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start));
+        return take(tail);
+    }
+
+	/// @brief Hands the held frame's slot back to the simulation thread. Render thread only.
+    void release() noexcept {
+        if (!m_held) return;
+        m_held = false;
+        m_stats.render.add(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - m_acquired_at));
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1);
+        wake();
+    }
+
+	/// @brief Get the per-stage timing. Render thread only.
+    [[nodiscard]] const PipelineStats& stats() const noexcept { return m_stats; }
+	/// @brief Clears the per-stage timing. Render thread only.
+    void reset_stats() noexcept { m_stats = PipelineStats{}; }
+	/// @brief Get the pipeline depth.
+    [[nodiscard]] size_t depth() const noexcept { return m_depth; }
+	/**
+	* @brief Sets the scheduling changes applied to the simulation thread as it starts. Call before start().
+	* @param tuning CPU affinity, real-time priority and timer resolution (see thread_tuning.hpp).
+	*/
+    void set_thread_tuning(const ThreadTuning& tuning) noexcept { m_tuning = tuning; }
+	/// @brief Get the tuning applied to the simulation thread.
+    [[nodiscard]] const ThreadTuning& thread_tuning() const noexcept { return m_tuning; }
+	/// @brief Get the k_tuned_* bits in effect on the simulation thread (0 until it has started).
+    [[nodiscard]] uint32_t thread_tuning_applied() const noexcept { return m_tuning_applied.load(std::memory_order_acquire); }
+	/// @brief Get the error code of the first tuning setting that failed on the simulation thread, or 0.
+    [[nodiscard]] int      thread_tuning_error() const noexcept { return m_tuning_error.load(std::memory_order_acquire); }
+
+	/// @brief Get the underlying runner, for configuration before start().
+    [[nodiscard]] runner_type& runner() noexcept { return m_runner; }
+
+private:
+	/// @brief Marks the slot at tail as held and records its simulation-side timing.
+    const frame_type* take(size_t tail) noexcept {
+        const frame_type& f = m_slots[tail % (m_depth + 1)];
+        m_held = true;
+        m_taken.store(tail + 1);
+        wake();
+        m_acquired_at = clock_type::now();
+        m_stats.tick.add(f.tick_cost);
+        m_stats.produce.add(f.produce_cost);
+        m_stats.stall.add(f.stall);
+        m_stats.latency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(m_acquired_at - f.produced));
+        ++m_stats.frames;
+        return &f;
+    }
+
+    void sim_main() noexcept {
+        const ScopedThreadTuning tuning{m_tuning};
+        m_tuning_error.store(tuning.error(), std::memory_order_release);
+        m_tuning_applied.store(tuning.applied(), std::memory_order_release);
+        const size_t slots = m_depth + 1;
+        uint64_t sequence = 0;
+        for (size_t head = 0; ; ++head) {
+            // Backpressure: wait while depth frames are ready; a held frame's slot is one of the other
+            // slots, since m_taken is at most m_tail + 1
+            const time_point stall_start = clock_type::now();
+            wait_until([&]{ return head - m_taken.load() < m_depth; });
+            if (m_stop.load(std::memory_order_acquire)) return;
+
+            const time_point tick_start = clock_type::now();
+            const double a = m_runner.tick();
+            const time_point produce_start = clock_type::now();
+            frame_type& f = m_slots[head % slots];
+            produce(a, f.frame);
+            f.produced      = clock_type::now();
+            f.sequence      = sequence++;
+            f.alpha         = a;
+            f.steps         = m_runner.last_steps();
+            f.stall         = std::chrono::duration_cast<std::chrono::nanoseconds>(tick_start - stall_start);
+            f.tick_cost     = std::chrono::duration_cast<std::chrono::nanoseconds>(produce_start - tick_start);
+            f.produce_cost  = std::chrono::duration_cast<std::chrono::nanoseconds>(f.produced - produce_start);
+            m_head.store(head + 1);
+            wake();
+        }
+    }
+
+	/**
+	* @brief Spins, then blocks, until ready() holds or a stop is requested.
+	* @details The counters ready() reads, the waiter count and the stores in wake()'s callers are all
+	*          sequentially consistent: either the waiter sees the new value, or the notifier sees the waiter.
+	*/
+    template <class Ready>
+    void wait_until(Ready&& ready) noexcept {
+        for (size_t spins = 0; spins < k_pipeline_spin_iterations; ++spins) {
+            if (ready() || m_stop.load()) return;
+            detail::cpu_relax();
+        }
+        std::unique_lock<std::mutex> lock(m_wait_mutex);
+        m_waiters.fetch_add(1);
+        m_wake.wait(lock, [&]{ return ready() || m_stop.load(); });
+        m_waiters.fetch_sub(1);
+    }
+
+	/// @brief Wakes the other side if it is blocked in wait_until(); call after publishing a counter.
+    void wake() noexcept {
+        if (m_waiters.load() == 0) return;
+        { std::lock_guard<std::mutex> lock(m_wait_mutex); }
+        m_wake.notify_all();
+    }
+
+    void produce(double a, Frame& out) noexcept {
+#if ISHAP_HAS_EXCEPTIONS
+        if constexpr (detail::catches_errors_v<AutoErrorPolicy, ProduceFn&, double, Frame&>) {
+            try {
+                detail::invoke_if_set(m_produce, a, out);
+            } catch (...) {
+                // Swallow exceptions from user code to maintain noexcept guarantee
+            }
+            return;
+        }
+#endif
+        detail::invoke_if_set(m_produce, a, out);
+    }
+
+private:
+    ProduceFn                       m_produce;
+    runner_type                     m_runner;
+    size_t                          m_depth{k_default_pipeline_depth};
+    std::unique_ptr<frame_type[]>   m_slots{};
+
+	// --- Simulation side ---
+    alignas(k_cache_line_size) std::atomic<size_t> m_head{0};
+
+	// --- Render side ---
+    alignas(k_cache_line_size) std::atomic<size_t> m_tail{0};
+	/// @brief Frames taken by acquire(): m_tail, plus one while a frame is held
+    std::atomic<size_t>             m_taken{0};
+    bool                            m_held{false};
+    time_point                      m_acquired_at{};
+    PipelineStats                   m_stats{};
+
+    std::atomic<bool>               m_stop{false};
+	/// @brief Threads blocked in wait_until() (at most one per side)
+    std::atomic<uint32_t>           m_waiters{0};
+    std::mutex                      m_wait_mutex{};
+    std::condition_variable         m_wake{};
+    ThreadTuning                    m_tuning{};
+    std::atomic<uint32_t>           m_tuning_applied{0};
+    std::atomic<int>                m_tuning_error{0};
+    std::thread                     m_thread{};
+};
+
+} // namespace ishap::timestep
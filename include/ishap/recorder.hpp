@@ -0,0 +1,190 @@
+// recorder.hpp — compact binary log of everything that drives a runner
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Stepping is deterministic for a given sequence of raw deltas and
+//   control changes; logging exactly that sequence makes a session
+//   replayable at full CPU speed (see replay.hpp)
+// - Records raw elapsed values as zigzag varints (a 60 Hz frame is 4 bytes
+//   plus a tag), pause state, reset and every config setter
+// - Buffered stdio writes, no exceptions; failures are sticky and queryable
+//
+// File layout
+//   header : "ISHR" magic, u8 version
+//   record : u8 tag, payload (varint for integers, 8 raw bytes for doubles)
+//
+// Usage
+//   ishap::timestep::Recorder recorder;
+//   if (recorder.open("session.ishr")) runner.set_recorder(&recorder);
+//
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace ishap::timestep {
+
+    inline constexpr char
+        k_replay_magic[4]                   = { 'I', 'S', 'H', 'R' };
+    inline constexpr uint8_t
+        k_replay_version                    = 1;
+    inline constexpr size_t
+        k_replay_header_size                = sizeof(k_replay_magic) + 1;
+
+/// @brief Record kinds of a replay file
+enum class ReplayTag : uint8_t {
+    elapsed             = 1,    ///< raw elapsed time fed to advance() (zigzag varint ns)
+    pause               = 2,    ///< pause state (u8: 0 = running, 1 = paused)
+    reset               = 3,    ///< reset() (no payload)
+    step                = 4,    ///< fixed step, from set_step() / set_hz() (varint ns)
+    time_scale          = 5,    ///< set_time_scale() (f64)
+    max_delta           = 6,    ///< set_max_delta() (varint ns)
+    max_substeps        = 7,    ///< set_max_substeps() (varint)
+    fast_forward_steps  = 8,    ///< fast_forward(steps), or a cancelled fast_forward(duration) (varint steps executed)
+    fast_forward_time   = 9,    ///< completed fast_forward(duration) (zigzag varint ns)
+    catch_up            = 10,   ///< set_catch_up() (u8 policy, varint frames, varint max extra steps)
+};
+
+namespace detail {
+
+    /// @brief Maps signed to unsigned so small magnitudes encode short.
+    [[nodiscard]] constexpr uint64_t zigzag_encode(int64_t v) noexcept {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+    /// @brief Inverse of zigzag_encode().
+    [[nodiscard]] constexpr int64_t zigzag_decode(uint64_t v) noexcept {
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+} // namespace detail
+
+/**
+* @brief Writes runner inputs to a replay file
+* @details Attach with set_recorder(); the runner calls the record_*() functions itself.
+*          Not thread-safe; used from the thread that drives the runner.
+*/
+class Recorder {
+public:
+    Recorder() = default;
+    Recorder(const Recorder&)            = delete;
+    Recorder& operator=(const Recorder&) = delete;
+    ~Recorder() { close(); }
+
+	/**
+	* @brief Creates (truncates) a replay file and writes its header.
+	* @param path The file path.
+	* @return False if the file could not be opened or the header not written.
+	*/
+    bool open(const char* path) noexcept {
+        close();
+        m_file = std::fopen(path, "wb");
+        m_failed = (m_file == nullptr);
+        m_count = 0;
+        if (m_failed) return false;
+        put_bytes(k_replay_magic, sizeof(k_replay_magic));
+        put_byte(k_replay_version);
+        return flush();
+    }
+
+	/// @brief Flushes buffered records and closes the file.
+    void close() noexcept {
+        if (!m_file) return;
+        flush();
+        if (std::fclose(m_file) != 0) m_failed = true;
+        m_file = nullptr;
+    }
+
+	/// @brief Writes buffered records to the file. Returns false on write failure.
+    bool flush() noexcept {
+        if (m_file && m_used > 0) {
+            if (std::fwrite(m_buffer.data(), 1, m_used, m_file) != m_used) m_failed = true;
+            m_used = 0;
+        }
+        return !m_failed;
+    }
+
+	/// @brief Returns whether a file is open.
+    [[nodiscard]] bool is_open() const noexcept { return m_file != nullptr; }
+	/// @brief Returns whether no open or write error has occurred.
+    [[nodiscard]] bool good() const noexcept    { return !m_failed; }
+	/// @brief Get the number of records written since open().
+    [[nodiscard]] uint64_t record_count() const noexcept { return m_count; }
+
+	/// @brief Records a raw elapsed time fed to advance().
+    void record_elapsed(std::chrono::nanoseconds elapsed) noexcept {
+        put_record(ReplayTag::elapsed); put_varint(detail::zigzag_encode(elapsed.count()));
+    }
+	/// @brief Records a pause state change.
+    void record_pause(bool paused) noexcept {
+        put_record(ReplayTag::pause); put_byte(paused ? 1 : 0);
+    }
+	/// @brief Records a reset().
+    void record_reset() noexcept { put_record(ReplayTag::reset); }
+	/// @brief Records a new fixed step duration.
+    void record_step(std::chrono::nanoseconds step) noexcept {
+        put_record(ReplayTag::step); put_varint(detail::zigzag_encode(step.count()));
+    }
+	/// @brief Records a new time scale.
+    void record_time_scale(double scale) noexcept {
+        put_record(ReplayTag::time_scale);
+        unsigned char bytes[sizeof(double)];
+        std::memcpy(bytes, &scale, sizeof(double));
+        put_bytes(bytes, sizeof(bytes));
+    }
+	/// @brief Records a new safety max delta.
+    void record_max_delta(std::chrono::nanoseconds d) noexcept {
+        put_record(ReplayTag::max_delta); put_varint(detail::zigzag_encode(d.count()));
+    }
+	/// @brief Records a new safety max substep count.
+    void record_max_substeps(size_t n) noexcept {
+        put_record(ReplayTag::max_substeps); put_varint(static_cast<uint64_t>(n));
+    }
+
+	/// @brief Records the steps executed by fast_forward(steps) or a cancelled fast_forward(duration).
+    void record_fast_forward_steps(size_t steps) noexcept {
+        put_record(ReplayTag::fast_forward_steps); put_varint(static_cast<uint64_t>(steps));
+    }
+	/// @brief Records a catch-up policy change.
+    void record_catch_up(uint8_t policy, size_t frames, size_t max_extra_steps) noexcept {
+        put_record(ReplayTag::catch_up); put_byte(policy);
+        put_varint(static_cast<uint64_t>(frames)); put_varint(static_cast<uint64_t>(max_extra_steps));
+    }
+	/// @brief Records a completed fast_forward(duration).
+    void record_fast_forward_time(std::chrono::nanoseconds duration) noexcept {
+        put_record(ReplayTag::fast_forward_time); put_varint(detail::zigzag_encode(duration.count()));
+    }
+
+private:
+    /// @brief Starts a record, making room for the largest payload (tag + u8 + two 10-byte varints).
+    void put_record(ReplayTag tag) noexcept {
+        if (!m_file) return;
+        if (m_buffer.size() - m_used < 32) flush();
+        put_byte(static_cast<uint8_t>(tag));
+        ++m_count;
+    }
+    void put_byte(uint8_t b) noexcept {
+        if (!m_file) return;
+        m_buffer[m_used++] = b;
+    }
+    void put_bytes(const void* data, size_t n) noexcept {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < n; ++i) put_byte(p[i]);
+    }
+    void put_varint(uint64_t v) noexcept {
+        while (v >= 0x80) { put_byte(static_cast<uint8_t>(v | 0x80)); v >>= 7; }
+        put_byte(static_cast<uint8_t>(v));
+    }
+
+private:
+    std::FILE*                      m_file{nullptr};
+    std::array<unsigned char, 4096> m_buffer{};
+    size_t                          m_used{0};
+    uint64_t                        m_count{0};
+    bool                            m_failed{false};
+};
+
+} // namespace ishap::timestep
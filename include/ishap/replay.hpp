@@ -0,0 +1,247 @@
+// replay.hpp — memory-mapped playback of recorder.hpp files
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Re-runs a recorded session through the runner's own advance() path at
+//   full CPU speed: hours of production time in seconds, no real-time waits
+// - The file is memory-mapped and decoded in place; no parsing pass, no
+//   allocations
+// - Malformed or truncated input stops playback and is reported, never UB
+//
+// Usage
+//   ishap::timestep::Replayer replayer;
+//   if (replayer.open("session.ishr")) {
+//       replayer.replay(runner);      // runner must not have a recorder attached
+//       if (replayer.malformed()) { /* truncated capture */ }
+//   }
+//
+#pragma once
+
+#include "ishap.hpp"
+#include "recorder.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ishap::timestep {
+
+/// @brief Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+	/**
+	* @brief Maps a file read-only.
+	* @param path The file path.
+	* @return False if the file could not be opened, is empty, or could not be mapped.
+	*/
+    bool open(const char* path) noexcept {
+        close();
+#if defined(_WIN32)
+        m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) { close(); return false; }
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping) { close(); return false; }
+        m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data) { close(); return false; }
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        m_data = static_cast<const unsigned char*>(p);
+        m_size = static_cast<size_t>(st.st_size);
+#endif
+        return true;
+    }
+
+	/// @brief Unmaps the file.
+    void close() noexcept {
+#if defined(_WIN32)
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+        m_mapping = nullptr;
+        m_file = INVALID_HANDLE_VALUE;
+#else
+        if (m_data) ::munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+	/// @brief Get the mapped bytes, or nullptr when not open.
+    [[nodiscard]] const unsigned char* data() const noexcept { return m_data; }
+	/// @brief Get the mapped size in bytes.
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+private:
+    const unsigned char*            m_data{nullptr};
+    size_t                          m_size{0};
+#if defined(_WIN32)
+    HANDLE                          m_file{INVALID_HANDLE_VALUE};
+    HANDLE                          m_mapping{nullptr};
+#endif
+};
+
+/**
+* @brief Feeds a recorded session back into a runner
+* @details Each record is applied through the runner's public API (push_time(), pause(), set_step() …),
+*          so playback exercises exactly the code paths that produced the recording.
+*/
+class Replayer {
+public:
+	/**
+	* @brief Maps a replay file and validates its header.
+	* @param path The file path.
+	* @return False if the file cannot be mapped or is not a replay file of a supported version.
+	*/
+    bool open(const char* path) noexcept {
+        m_malformed = false;
+        m_events = 0;
+        if (!m_file.open(path)) return false;
+        if (m_file.size() < k_replay_header_size ||
+            std::memcmp(m_file.data(), k_replay_magic, sizeof(k_replay_magic)) != 0 ||
+            m_file.data()[sizeof(k_replay_magic)] != k_replay_version) {
+            m_file.close();
+            return false;
+        }
+        rewind();
+        return true;
+    }
+
+	/// @brief Restarts playback from the first record.
+    void rewind() noexcept { m_pos = k_replay_header_size; m_events = 0; m_malformed = false; }
+
+	/**
+	* @brief Applies the next record to the runner.
+	* @return False at the end of the file or on malformed input (see malformed()).
+	* @details Under PropagateErrors a throwing step propagates out of here; the record counts as consumed.
+	*/
+    template <class Runner>
+    bool replay_next(Runner& runner) noexcept(Runner::k_nothrow) {
+        if (!m_file.data() || m_pos >= m_file.size() || m_malformed) return false;
+        const auto tag = static_cast<ReplayTag>(m_file.data()[m_pos++]);
+        uint64_t v = 0;
+        switch (tag) {
+        case ReplayTag::elapsed:
+            if (!read_varint(v)) return fail();
+            (void)runner.push_time(std::chrono::nanoseconds(detail::zigzag_decode(v)));
+            break;
+        case ReplayTag::pause:
+            if (m_pos >= m_file.size()) return fail();
+            runner.pause(m_file.data()[m_pos++] != 0);
+            break;
+        case ReplayTag::reset:
+            runner.reset(false);
+            break;
+        case ReplayTag::step:
+            if (!read_varint(v)) return fail();
+            runner.set_step(std::chrono::nanoseconds(detail::zigzag_decode(v)));
+            break;
+        case ReplayTag::time_scale: {
+            if (m_file.size() - m_pos < sizeof(double)) return fail();
+            double scale = 0.0;
+            std::memcpy(&scale, m_file.data() + m_pos, sizeof(double));
+            m_pos += sizeof(double);
+            runner.set_time_scale(scale);
+            break;
+        }
+        case ReplayTag::max_delta:
+            if (!read_varint(v)) return fail();
+            runner.set_max_delta(std::chrono::nanoseconds(detail::zigzag_decode(v)));
+            break;
+        case ReplayTag::max_substeps:
+            if (!read_varint(v)) return fail();
+            runner.set_max_substeps(static_cast<size_t>(v));
+            break;
+        case ReplayTag::fast_forward_steps:
+            if (!read_varint(v)) return fail();
+            (void)runner.fast_forward(static_cast<size_t>(v));
+            break;
+        case ReplayTag::fast_forward_time:
+            if (!read_varint(v)) return fail();
+            (void)runner.fast_forward(std::chrono::nanoseconds(detail::zigzag_decode(v)));
+            break;
+        case ReplayTag::catch_up: {
+            if (m_pos >= m_file.size()) return fail();
+            const uint8_t policy = m_file.data()[m_pos++];
+            if (policy > static_cast<uint8_t>(CatchUpPolicy::smooth)) return fail();
+            uint64_t extra = 0;
+            if (!read_varint(v) || !read_varint(extra)) return fail();
+            runner.set_catch_up(static_cast<CatchUpPolicy>(policy), static_cast<size_t>(v), static_cast<size_t>(extra));
+            break;
+        }
+        default:
+            return fail();
+        }
+        ++m_events;
+        return true;
+    }
+
+	/**
+	* @brief Applies all remaining records to the runner.
+	* @return The number of records applied by this call.
+	*/
+    template <class Runner>
+    size_t replay(Runner& runner) noexcept(Runner::k_nothrow) {
+        const size_t before = m_events;
+        while (replay_next(runner)) {}
+        return m_events - before;
+    }
+
+	/// @brief Returns whether playback stopped on a truncated or unknown record.
+    [[nodiscard]] bool malformed() const noexcept { return m_malformed; }
+	/// @brief Returns whether every record has been applied.
+    [[nodiscard]] bool finished() const noexcept { return !m_file.data() || m_pos >= m_file.size(); }
+	/// @brief Get the number of records applied since open() or rewind().
+    [[nodiscard]] size_t events_replayed() const noexcept { return m_events; }
+
+private:
+    bool fail() noexcept { m_malformed = true; return false; }
+
+    bool read_varint(uint64_t& out) noexcept {
+        out = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (m_pos >= m_file.size()) return false;
+            const uint8_t b = m_file.data()[m_pos++];
+            out |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+private:
+    MappedFile                      m_file{};
+    size_t                          m_pos{0};
+    size_t                          m_events{0};
+    bool                            m_malformed{false};
+};
+
+} // namespace ishap::timestep
@@ -0,0 +1,111 @@
+// rollback.hpp — fixed-capacity snapshot ring keyed by tick, for rollback netcode
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Rollback netcode saves the state before every step, and when a late
+//   input arrives for tick t it restores that state, rewinds the runner with
+//   rollback_to(t) and catches up with resimulate(n)
+// - RollbackBuffer holds the last Capacity snapshots in one std::array,
+//   slot tick % Capacity: saving and finding are an index and a compare, no
+//   allocation and no search
+// - Each slot remembers its tick, so a snapshot overwritten by a newer one
+//   (or never saved) is reported as missing instead of restored by mistake
+// - Convention: the snapshot for tick t is the state before step t, i.e.
+//   saved inside the step function under runner.step_index()
+//
+// Usage
+//   ishap::timestep::RollbackBuffer<World, 8> snapshots;
+//   runner.set_step_function([&](std::chrono::nanoseconds dt){
+//       snapshots.save(runner.step_index(), world);
+//       simulate(world, inputs.at(runner.step_index()), dt);
+//   });
+//   // Late input for tick t:
+//   const uint64_t now = runner.step_index();
+//   if (snapshots.restore(t, world) && runner.rollback_to(t)) runner.resimulate(now - t);
+//
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_default_rollback_capacity         = 8;
+
+/**
+* @brief Ring of the last Capacity state snapshots, addressed by tick
+* @tparam T The state type. Default-constructed once per slot; save() copies into the slot in place.
+* @tparam Capacity Number of ticks that can be rolled back. A power of two keeps the slot lookup a mask.
+* @details Not thread-safe.
+*/
+template <class T, size_t Capacity = k_default_rollback_capacity>
+class RollbackBuffer {
+    static_assert(Capacity > 0, "RollbackBuffer needs at least one slot");
+public:
+    using value_type = T;
+
+    RollbackBuffer() = default;
+
+	/**
+	* @brief Claims the slot for a tick, for the caller to fill in place.
+	* @param tick The tick the snapshot belongs to. Evicts tick - Capacity.
+	* @return The slot, still holding whatever it held before.
+	*/
+    [[nodiscard]] T& save(uint64_t tick) noexcept {
+        Slot& slot = m_slots[tick % Capacity];
+        slot.tick = tick;
+        return slot.value;
+    }
+
+	/**
+	* @brief Copies a snapshot into the slot for a tick.
+	* @param tick The tick the snapshot belongs to. Evicts tick - Capacity.
+	* @param state The state before step tick.
+	*/
+    void save(uint64_t tick, const T& state) { save(tick) = state; }
+
+	/**
+	* @brief Finds the snapshot of a tick.
+	* @return The snapshot, or nullptr if it was never saved or has been evicted.
+	*/
+    [[nodiscard]] const T* find(uint64_t tick) const noexcept {
+        const Slot& slot = m_slots[tick % Capacity];
+        return slot.tick == tick && tick != k_empty ? &slot.value : nullptr;
+    }
+
+	/**
+	* @brief Copies the snapshot of a tick into a state.
+	* @return False (state untouched) if the snapshot is missing.
+	*/
+    bool restore(uint64_t tick, T& state) const {
+        const T* saved = find(tick);
+        if (!saved) return false;
+        state = *saved;
+        return true;
+    }
+
+	/// @brief Drops every snapshot newer than tick, e.g. after a rollback that will save them again.
+    void invalidate_after(uint64_t tick) noexcept {
+        for (auto& slot : m_slots) if (slot.tick != k_empty && slot.tick > tick) slot.tick = k_empty;
+    }
+
+	/// @brief Drops every snapshot. The slots keep their values.
+    void clear() noexcept { for (auto& slot : m_slots) slot.tick = k_empty; }
+
+	/// @brief Get the number of ticks that can be rolled back.
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+    static constexpr uint64_t k_empty = UINT64_MAX;
+
+    struct Slot {
+        T                           value{};
+        uint64_t                    tick{k_empty};
+    };
+
+    std::array<Slot, Capacity>      m_slots{};
+};
+
+} // namespace ishap::timestep
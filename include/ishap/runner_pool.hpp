@@ -0,0 +1,274 @@
+// runner_pool.hpp — structure-of-arrays timekeeping for many independent sessions
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Thousands of FixedTimestepRunner objects scatter accumulators, configs
+//   and two std::function targets each across the heap
+// - RunnerPool keeps every per-session field in its own contiguous array and
+//   updates all accumulators in one branch-light pass per frame
+// - The pool only does the timekeeping: it reports how many steps each
+//   session is due, and the caller dispatches them (serially or in parallel)
+// - Per-session semantics are those of advance(): clamp, time scale,
+//   substep cap, accumulator trim
+//
+// Usage
+//   ishap::timestep::RunnerPool pool;
+//   const size_t id = pool.add({.step = ishap::timestep::k_step_60hz});
+//   for (;;) {
+//       pool.tick();
+//       pool.for_each_due([&](size_t session, size_t steps, std::chrono::nanoseconds dt){
+//           for (size_t s = 0; s < steps; ++s) sessions[session].step(dt);
+//       });
+//   }
+//
+#pragma once
+
+#include "ishap.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ishap::timestep {
+
+/**
+* @brief Timekeeping for many sessions stored as contiguous per-field arrays
+* @details Sessions are addressed by index. remove() moves the last session into the freed slot.
+*          Storage grows only in add()/reserve(); advancing never allocates.
+*/
+class RunnerPool {
+public:
+    using rep = std::chrono::nanoseconds::rep;
+    using steady_clock = std::chrono::steady_clock;
+
+    RunnerPool() { m_last = steady_clock::now(); }
+
+	/**
+	* @brief Adds a session.
+	* @param config The session's configuration.
+	* @return The index of the new session.
+	*/
+    size_t add(const Config& config = {}) {
+        m_accumulator.push_back(0);
+        m_step.push_back(0);
+        m_time_scale.push_back(k_default_time_scale);
+        m_max_delta.push_back(0);
+        m_max_substeps.push_back(k_default_max_substeps);
+        m_overflow.push_back(k_default_max_accumulator_overflow);
+        m_max_accumulator.push_back(0);
+        m_paused.push_back(0);
+        m_due.push_back(0);
+        const size_t index = m_step.size() - 1;
+        set_config(index, config);
+        return index;
+    }
+
+	/**
+	* @brief Removes a session by moving the last session into its slot.
+	* @param index The session to remove; must be below size(), otherwise nothing is removed.
+	* @return The previous index of the session that now lives at `index` (equal to `index` if it was the last,
+	*         or if nothing was removed).
+	*/
+    size_t remove(size_t index) noexcept {
+        if (index >= size()) return index;
+        const size_t last = size() - 1;
+        if (index != last) {
+            m_accumulator[index]        = m_accumulator[last];
+            m_step[index]               = m_step[last];
+            m_time_scale[index]         = m_time_scale[last];
+            m_max_delta[index]          = m_max_delta[last];
+            m_max_substeps[index]       = m_max_substeps[last];
+            m_overflow[index]           = m_overflow[last];
+            m_max_accumulator[index]    = m_max_accumulator[last];
+            m_paused[index]             = m_paused[last];
+            m_due[index]                = m_due[last];
+        }
+        m_accumulator.pop_back(); m_step.pop_back(); m_time_scale.pop_back(); m_max_delta.pop_back();
+        m_max_substeps.pop_back(); m_overflow.pop_back(); m_max_accumulator.pop_back();
+        m_paused.pop_back(); m_due.pop_back();
+        return last;
+    }
+
+	/// @brief Reserves storage for n sessions.
+    void reserve(size_t n) {
+        m_accumulator.reserve(n); m_step.reserve(n); m_time_scale.reserve(n); m_max_delta.reserve(n);
+        m_max_substeps.reserve(n); m_overflow.reserve(n); m_max_accumulator.reserve(n);
+        m_paused.reserve(n); m_due.reserve(n);
+    }
+
+	/// @brief Removes all sessions.
+    void clear() noexcept {
+        m_accumulator.clear(); m_step.clear(); m_time_scale.clear(); m_max_delta.clear();
+        m_max_substeps.clear(); m_overflow.clear(); m_max_accumulator.clear();
+        m_paused.clear(); m_due.clear();
+        m_total_due = 0;
+    }
+
+	/// @brief Get the number of sessions.
+    [[nodiscard]] size_t size() const noexcept { return m_step.size(); }
+
+	/**
+	* @brief Replaces a session's configuration, keeping its accumulator.
+	* @details Invalid values are handled as by the runner setters (ignored or clamped).
+	*          The catch-up policy is not used: sessions always drop (CatchUpPolicy::drop).
+	*/
+    void set_config(size_t index, const Config& config) noexcept {
+        if (config.step.count() > 0)                m_step[index] = config.step.count();
+        else if (m_step[index] == 0)                m_step[index] = k_step_60hz.count();
+        if (config.safety_max_delta.count() > 0)    m_max_delta[index] = config.safety_max_delta.count();
+        else if (m_max_delta[index] == 0)           m_max_delta[index] = k_default_max_delta.count();
+        m_time_scale[index]     = config.time_scale < 0.0 ? 0.0 : config.time_scale;
+        m_max_substeps[index]   = config.safety_max_substeps > 0 ? config.safety_max_substeps : size_t{1};
+        m_overflow[index]       = config.safety_max_accumulator_overflow;
+        update_max_accumulator(index);
+    }
+
+	/// @brief Get a session's configuration.
+    [[nodiscard]] Config config(size_t index) const noexcept {
+        Config c;
+        c.step                              = std::chrono::nanoseconds(m_step[index]);
+        c.time_scale                        = m_time_scale[index];
+        c.safety_max_delta                  = std::chrono::nanoseconds(m_max_delta[index]);
+        c.safety_max_substeps               = m_max_substeps[index];
+        c.safety_max_accumulator_overflow   = m_overflow[index];
+        return c;
+    }
+
+	/// @brief Sets a session's fixed step. Non-positive values are ignored.
+    void set_step(size_t index, std::chrono::nanoseconds s) noexcept {
+        if (s.count() <= 0) return;
+        m_step[index] = s.count();
+        update_max_accumulator(index);
+    }
+	/// @brief Get a session's fixed step.
+    [[nodiscard]] std::chrono::nanoseconds step(size_t index) const noexcept { return std::chrono::nanoseconds(m_step[index]); }
+
+	/// @brief Sets a session's time scale. Negative values are clamped to 0.0.
+    void set_time_scale(size_t index, double s) noexcept { m_time_scale[index] = s < 0.0 ? 0.0 : s; }
+	/// @brief Get a session's time scale.
+    [[nodiscard]] double time_scale(size_t index) const noexcept { return m_time_scale[index]; }
+
+	/// @brief Pauses or unpauses a session.
+    void pause(size_t index, bool p = true) noexcept { m_paused[index] = p ? 1 : 0; }
+	/// @brief Returns whether a session is paused.
+    [[nodiscard]] bool paused(size_t index) const noexcept { return m_paused[index] != 0; }
+
+	/**
+	* @brief Advances every session using a single read of the steady clock.
+	* @return The total number of steps due across all sessions.
+	*/
+    size_t tick() noexcept {
+        const auto now = steady_clock::now();
+        const auto raw = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last);
+        m_last = now;
+        return advance(raw);
+    }
+
+	/**
+	* @brief Advances every session by the same externally provided elapsed time.
+	* @return The total number of steps due across all sessions.
+	*/
+    size_t push_time(std::chrono::nanoseconds elapsed) noexcept { return advance(elapsed); }
+
+	/// @brief Get the number of steps a session is due after the last tick.
+    [[nodiscard]] size_t due(size_t index) const noexcept { return m_due[index]; }
+	/// @brief Get the due step counts of all sessions, indexed by session.
+    [[nodiscard]] const size_t* due_data() const noexcept { return m_due.data(); }
+	/// @brief Get the total number of steps due after the last tick.
+    [[nodiscard]] size_t total_due() const noexcept { return m_total_due; }
+
+	/**
+	* @brief Calls fn(session, steps, step) for every session with steps due after the last tick.
+	* @param fn Callable invoked as fn(size_t session, size_t steps, std::chrono::nanoseconds step).
+	*/
+    template <class Fn>
+    void for_each_due(Fn&& fn) const {
+        const size_t n = size();
+        for (size_t i = 0; i < n; ++i) {
+            if (m_due[i] != 0) fn(i, m_due[i], std::chrono::nanoseconds(m_step[i]));
+        }
+    }
+
+	/// @brief Get a session's accumulator.
+    [[nodiscard]] std::chrono::nanoseconds accumulator(size_t index) const noexcept { return std::chrono::nanoseconds(m_accumulator[index]); }
+	/// @brief Get a session's interpolation factor.
+    [[nodiscard]] double alpha(size_t index) const noexcept {
+        return static_cast<double>(m_accumulator[index]) / static_cast<double>(m_step[index]);
+    }
+	/// @brief Get the last frame's raw delta time before clamping and time scaling.
+    [[nodiscard]] std::chrono::nanoseconds last_delta() const noexcept { return m_last_delta; }
+
+private:
+    void update_max_accumulator(size_t index) noexcept {
+        m_max_accumulator[index] = m_step[index] * static_cast<rep>(m_overflow[index]);
+    }
+
+	/**
+	* @brief One pass over all sessions: clamp, scale, accumulate, count due steps, trim.
+	* @details Mirrors BasicFixedTimestepRunner::advance() per session, with the step loop replaced by a
+	*          division; paused sessions are skipped: no steps due and the accumulator is left unchanged.
+	*/
+    size_t advance(std::chrono::nanoseconds raw_elapsed) noexcept {
+        m_last_delta = raw_elapsed;
+        const rep raw = raw_elapsed.count();
+        const size_t n = size();
+
+        rep* const          acc         = m_accumulator.data();
+        const rep* const    step        = m_step.data();
+        const double* const scale       = m_time_scale.data();
+        const rep* const    max_delta   = m_max_delta.data();
+        const size_t* const max_sub     = m_max_substeps.data();
+        const rep* const    max_acc     = m_max_accumulator.data();
+        const uint8_t* const paused     = m_paused.data();
+        size_t* const       due         = m_due.data();
+
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i) {
+            // Paused: no steps and the accumulator is kept as is (prior debt is not drained either)
+            if (paused[i]) {
+                due[i] = 0;
+                continue;
+            }
+
+            // Clamp [Safety] + Time scale
+            rep dt = raw < max_delta[i] ? raw : max_delta[i];
+            dt = scale[i] == 1.0 ? dt : static_cast<rep>(static_cast<double>(dt) * scale[i]);
+            const rep a = acc[i] + dt;
+
+            // Due steps [with Safety Cap]
+            const rep pending = a >= step[i] ? a / step[i] : rep{0};
+            const rep cap = static_cast<rep>(max_sub[i]);
+            const rep steps = pending < cap ? pending : cap;
+
+            // Trim excess accumulator [With Safety Cap]
+            const rep left = a - steps * step[i];
+            acc[i] = left > max_acc[i] ? max_acc[i] : left;
+            due[i] = static_cast<size_t>(steps);
+            total += static_cast<size_t>(steps);
+        }
+        m_total_due = total;
+        return total;
+    }
+
+private:
+	// --- Per-session fields (structure of arrays) ---
+    std::vector<rep>                m_accumulator{};
+    std::vector<rep>                m_step{};
+    std::vector<double>             m_time_scale{};
+    std::vector<rep>                m_max_delta{};
+    std::vector<size_t>             m_max_substeps{};
+    std::vector<size_t>             m_overflow{};
+	/// @brief step * overflow, precomputed so the update pass does not multiply
+    std::vector<rep>                m_max_accumulator{};
+    std::vector<uint8_t>            m_paused{};
+	/// @brief Steps due per session after the last tick
+    std::vector<size_t>             m_due{};
+
+	/// @brief Last time point recorded (for tick())
+    steady_clock::time_point        m_last{};
+    std::chrono::nanoseconds        m_last_delta{0};
+    size_t                          m_total_due{0};
+};
+
+} // namespace ishap::timestep
@@ -0,0 +1,132 @@
+// state_history.hpp — preallocated previous/current state slots for alpha interpolation
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Rendering between fixed steps needs the previous and the current state;
+//   copying the whole world into a "previous" buffer every step is wasteful
+// - StateHistory keeps 2 (double-buffered) or more slots in place and
+//   rotates an index on each step: the oldest slot becomes the new current
+//   one, nothing is copied
+// - interpolate(alpha) consumes tick()'s return value directly
+// - For large SoA worlds the blend itself can use the vectorized lerp() /
+//   nlerp() kernels of interpolate.hpp
+//
+// Usage
+//   ishap::timestep::StateHistory<World> history{initial_world};
+//   runner.set_step_function([&](std::chrono::nanoseconds dt){
+//       history.step([&](const World& prev, World& next){ simulate(prev, next, dt); });
+//   });
+//   for (;;) {
+//       const double a = runner.tick();
+//       render(history.interpolate(a, [](const World& p, const World& c, double t){ return blend(p, c, t); }));
+//   }
+//
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace ishap::timestep {
+
+/**
+* @brief Fixed ring of state slots; the newest is current(), the one before it previous()
+* @tparam T The state type. Default-constructed (or copy-initialised) once, never copied per step.
+* @tparam Slots Number of slots: 2 for double buffering, 3 to also keep the state before previous().
+* @details advance() hands out the oldest slot as the new current state. That slot still holds the
+*          state from Slots - 1 steps ago, so the step must overwrite it completely.
+*/
+template <class T, size_t Slots = 2>
+class StateHistory {
+    static_assert(Slots >= 2, "StateHistory needs at least a previous and a current slot");
+public:
+    using value_type = T;
+
+    StateHistory() = default;
+
+	/**
+	* @brief Constructs the history with every slot initialised to the same state.
+	* @param initial The initial state, so interpolation before the first step is well defined.
+	*/
+    explicit StateHistory(const T& initial) { reset(initial); }
+
+	/// @brief Sets every slot to the given state.
+    void reset(const T& state) {
+        for (auto& slot : m_slots) slot = state;
+        m_head = 0;
+    }
+
+	/**
+	* @brief Rotates the slots: the old current becomes previous, the oldest slot becomes current.
+	* @return The new current slot, to be overwritten by the step.
+	*/
+    T& advance() noexcept {
+        m_head = (m_head + 1) % Slots;
+        return m_slots[m_head];
+    }
+
+	/**
+	* @brief Advances the history and runs one step on it.
+	* @param fn Callable invoked as fn(const T& previous, T& next).
+	*/
+    template <class Fn>
+    void step(Fn&& fn) {
+        T& next = advance();
+        fn(static_cast<const T&>(previous()), next);
+    }
+
+	/// @brief Get the newest state.
+    [[nodiscard]] T&       current() noexcept           { return m_slots[m_head]; }
+	/// @brief Get the newest state.
+    [[nodiscard]] const T& current() const noexcept     { return m_slots[m_head]; }
+	/// @brief Get the state one step before current().
+    [[nodiscard]] const T& previous() const noexcept    { return at(1); }
+
+	/**
+	* @brief Get a state by age.
+	* @param age 0 for current(), 1 for previous(), up to Slots - 1.
+	*/
+    [[nodiscard]] const T& at(size_t age) const noexcept {
+        return m_slots[(m_head + Slots - (age % Slots)) % Slots];
+    }
+
+	/**
+	* @brief Interpolates between previous() and current() with a user blend function.
+	* @param alpha The interpolation factor, typically the value returned by tick().
+	* @param fn Callable invoked as fn(const T& previous, const T& current, double alpha).
+	* @return Whatever fn returns.
+	*/
+    template <class Fn>
+    decltype(auto) interpolate(double alpha, Fn&& fn) const {
+        return std::forward<Fn>(fn)(previous(), current(), alpha);
+    }
+
+	/**
+	* @brief Linearly interpolates between previous() and current().
+	* @param alpha The interpolation factor, typically the value returned by tick().
+	* @details Available for arithmetic types and for types providing a + (b - a) * double.
+	*/
+    template <class U = T>
+    [[nodiscard]] auto interpolate(double alpha) const
+        -> decltype(std::declval<const U&>() + (std::declval<const U&>() - std::declval<const U&>()) * alpha, U{}) {
+        const T& a = previous();
+        const T& b = current();
+        if constexpr (std::is_arithmetic_v<T>) {
+            return static_cast<T>(a + (b - a) * alpha);
+        } else {
+            return a + (b - a) * alpha;
+        }
+    }
+
+	/// @brief Number of slots.
+    [[nodiscard]] static constexpr size_t slots() noexcept { return Slots; }
+
+private:
+	/// @brief Preallocated state slots
+    std::array<T, Slots>            m_slots{};
+	/// @brief Index of the current slot
+    size_t                          m_head{0};
+};
+
+} // namespace ishap::timestep
@@ -0,0 +1,222 @@
+// static_runner.hpp — fixed timestep runner with compile-time step and safety limits
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Most runners use a constant rate (k_step_120hz …), yet the general
+//   runner divides by a runtime step for alpha(), compares against it in
+//   the step loop and rebuilds step * overflow on every advance()
+// - StaticFixedTimestepRunner takes the step, substep cap, accumulator
+//   overflow and max delta as template constants: alpha() is a multiply by
+//   a folded reciprocal, the trim bound is a constant, and the loop bounds
+//   are immediates
+// - Only the state a tick needs is stored (no config, telemetry or
+//   attachments): with a small step callable the object fits in one cache
+//   line, for pooled and many-instance use
+// - Same semantics as BasicFixedTimestepRunner::advance() with the drop
+//   catch-up policy; the error policy of error_policy.hpp applies, except
+//   CatchAndReport (there is no error function to report to)
+//
+// Usage
+//   auto runner = ishap::timestep::make_static_runner<ishap::timestep::k_step_120hz.count()>(
+//       [&](std::chrono::nanoseconds dt) noexcept { physics.step(dt); });
+//   const double a = runner.tick();
+//
+#pragma once
+
+#include "ishap.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace ishap::timestep {
+
+/**
+* @brief Fixed timestep runner whose step and safety limits are compile-time constants
+* @tparam StepNs Fixed step in nanoseconds.
+* @tparam MaxSubsteps Maximum steps per tick.
+* @tparam MaxOverflow Accumulator bound, in steps.
+* @tparam StepFn Callable invoked as void(std::chrono::nanoseconds) for each fixed step. Stored by value.
+* @tparam Clock Steady clock read by tick().
+* @tparam ErrorPolicy How exceptions from the step function are handled (see error_policy.hpp).
+* @tparam MaxDeltaNs Safety max delta in nanoseconds.
+*/
+template <std::chrono::nanoseconds::rep StepNs,
+          size_t MaxSubsteps = k_default_max_substeps,
+          size_t MaxOverflow = k_default_max_accumulator_overflow,
+          class StepFn = std::function<void(std::chrono::nanoseconds)>,
+          class Clock = std::chrono::steady_clock,
+          class ErrorPolicy = AutoErrorPolicy,
+          std::chrono::nanoseconds::rep MaxDeltaNs = k_default_max_delta.count()>
+class StaticFixedTimestepRunner {
+    static_assert(StepNs > 0, "StaticFixedTimestepRunner needs a positive step");
+    static_assert(MaxSubsteps > 0, "StaticFixedTimestepRunner needs at least one substep");
+    static_assert(MaxDeltaNs > 0, "StaticFixedTimestepRunner needs a positive max delta");
+    static_assert(Clock::is_steady, "StaticFixedTimestepRunner needs a steady clock");
+    static_assert(!std::is_same_v<ErrorPolicy, CatchAndReport>,
+                  "StaticFixedTimestepRunner has no error function to report to; use AutoErrorPolicy "
+                  "(caught errors show in step_error_caught()) or BasicFixedTimestepRunner");
+public:
+    using rep = std::chrono::nanoseconds::rep;
+    using OnStepFunction = StepFn;
+    using clock_type = Clock;
+    using time_point = typename clock_type::time_point;
+    using error_policy = ErrorPolicy;
+
+    static constexpr std::chrono::nanoseconds   k_step          { StepNs };
+    static constexpr size_t                     k_max_substeps  = MaxSubsteps;
+    static constexpr std::chrono::nanoseconds   k_max_delta     { MaxDeltaNs };
+	/// @brief Accumulator bound (step * overflow), folded at compile time
+    static constexpr rep                        k_max_accumulator = StepNs * static_cast<rep>(MaxOverflow);
+	/// @brief Whether tick() and push_time() are noexcept
+    static constexpr bool                       k_nothrow       = !detail::propagates_errors_v<ErrorPolicy>;
+
+    StaticFixedTimestepRunner() = default;
+
+	/**
+	* @brief Constructs a runner with the given step function; timing starts now.
+	* @param fn The function to call for each fixed update step.
+	*/
+    explicit StaticFixedTimestepRunner(OnStepFunction fn) : m_on_update_function(std::move(fn)) { reset(true); }
+
+	/**
+	* @brief Resets the accumulator and pause state.
+	* @param start_now If true, sets the last time point to the current time.
+	*/
+    void reset(bool start_now = true) noexcept {
+        m_accumulator = 0;
+        m_last_steps = 0;
+        m_paused = false;
+        if (start_now) { m_last = clock_type::now(); m_has_last = true; }
+    }
+
+	/**
+	* @brief Advances the runner using the current time from the runner's clock.
+	* @return The interpolation alpha value in the range [0, 1).
+	*/
+    [[nodiscard]] double tick() noexcept(k_nothrow) {
+        const time_point now = clock_type::now();
+        if (!m_has_last || m_paused) { m_last = now; m_has_last = true; m_last_steps = 0; return alpha(); }
+        const auto raw = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last);
+        m_last = now;
+        return advance(raw.count());
+    }
+
+	/**
+	* @brief Advances the runner using an externally provided elapsed time.
+	* @param elapsed The elapsed time since the last call.
+	* @return The interpolation alpha value in the range [0, 1).
+	*/
+    [[nodiscard]] double push_time(std::chrono::nanoseconds elapsed) noexcept(k_nothrow) {
+        if (m_paused) { m_last_steps = 0; return alpha(); }
+        return advance(elapsed.count());
+    }
+
+	/// @brief Get the interpolation factor for the last frame.
+    [[nodiscard]] double alpha() const noexcept { return static_cast<double>(m_accumulator) * k_inv_step; }
+
+	/// @brief Sets the time scale factor. Negative values are clamped to 0.0.
+    void   set_time_scale(double s) noexcept { m_time_scale = s < 0.0 ? 0.0 : s; }
+	/// @brief Get the current time scale factor.
+    [[nodiscard]] double time_scale() const noexcept { return m_time_scale; }
+
+	/// @brief Pauses or unpauses the runner.
+    void   pause(bool p = true) noexcept { m_paused = p; }
+	/// @brief Returns whether the runner is paused.
+    [[nodiscard]] bool paused() const noexcept { return m_paused; }
+	/// @brief Unpauses the runner. Alias for pause(false).
+    void   resume() noexcept { pause(false); }
+
+	/// @brief Get the fixed step.
+    [[nodiscard]] static constexpr std::chrono::nanoseconds step() noexcept { return k_step; }
+	/// @brief Get the fixed update rate in Hertz.
+    [[nodiscard]] static constexpr double hz() noexcept { return 1e9 / static_cast<double>(StepNs); }
+	/// @brief Get the current accumulator value.
+    [[nodiscard]] std::chrono::nanoseconds accumulator() const noexcept { return std::chrono::nanoseconds(m_accumulator); }
+	/// @brief Get the number of fixed steps executed in the last tick.
+    [[nodiscard]] size_t last_steps() const noexcept { return m_last_steps; }
+	/// @brief Returns whether a step error was caught during the last tick (always false when the policy does not catch).
+    [[nodiscard]] bool step_error_caught() const noexcept { return m_step_error_caught; }
+
+	/// @brief Sets the step function.
+    void   set_step_function(OnStepFunction fn) { m_on_update_function = std::move(fn); }
+
+private:
+    static constexpr double k_inv_step = 1.0 / static_cast<double>(StepNs);
+
+	/// @brief Takes a step's time from the accumulator and counts it, also when the step function throws
+    struct StepCommit {
+        StaticFixedTimestepRunner&  self;
+        size_t&                     steps;
+        ~StepCommit() {
+            self.m_accumulator -= StepNs;
+            self.m_last_steps = ++steps;
+        }
+    };
+
+	/// @brief Clamp, scale, step, trim; mirrors BasicFixedTimestepRunner::advance() with constant bounds.
+    [[nodiscard]] double advance(rep raw) noexcept(k_nothrow) {
+        m_step_error_caught = false;
+
+		// Clamp [Safety] + Time scale
+        rep dt = raw < MaxDeltaNs ? raw : MaxDeltaNs;
+        if (m_time_scale != 1.0) dt = static_cast<rep>(static_cast<double>(dt) * m_time_scale);
+        m_accumulator += dt;
+
+        // Step Loop [with Safety Cap]
+        size_t steps = 0;
+        while (m_accumulator >= StepNs && steps < MaxSubsteps) {
+            const StepCommit commit{*this, steps};
+            call_step();
+        }
+        m_last_steps = steps;
+
+		// Trim excess accumulator [With Safety Cap]
+        if (m_accumulator > k_max_accumulator) m_accumulator = k_max_accumulator;
+        return alpha();
+    }
+
+    void call_step() noexcept(k_nothrow) {
+#if ISHAP_HAS_EXCEPTIONS
+        if constexpr (detail::catches_errors_v<ErrorPolicy, StepFn&, std::chrono::nanoseconds>) {
+            try {
+                detail::invoke_if_set(m_on_update_function, k_step);
+            } catch (...) {
+                m_step_error_caught = true;
+                // Swallow exceptions from user code to maintain noexcept guarantee
+            }
+            return;
+        }
+#endif
+        detail::invoke_if_set(m_on_update_function, k_step);
+    }
+
+private:
+    OnStepFunction                  m_on_update_function{};
+    time_point                      m_last{};
+    rep                             m_accumulator{0};
+    double                          m_time_scale{k_default_time_scale};
+    size_t                          m_last_steps{0};
+    bool                            m_paused{false};
+    bool                            m_has_last{false};
+    bool                            m_step_error_caught{false};
+};
+
+/**
+* @brief Creates a StaticFixedTimestepRunner, deducing the step callable type.
+* @tparam StepNs Fixed step in nanoseconds, e.g. k_step_120hz.count().
+* @tparam MaxSubsteps Maximum steps per tick.
+* @tparam MaxOverflow Accumulator bound, in steps.
+* @param fn The step function, stored by value.
+*/
+template <std::chrono::nanoseconds::rep StepNs,
+          size_t MaxSubsteps = k_default_max_substeps,
+          size_t MaxOverflow = k_default_max_accumulator_overflow,
+          class StepFn>
+[[nodiscard]] auto make_static_runner(StepFn&& fn) {
+    return StaticFixedTimestepRunner<StepNs, MaxSubsteps, MaxOverflow, std::decay_t<StepFn>>{std::forward<StepFn>(fn)};
+}
+
+} // namespace ishap::timestep
@@ -0,0 +1,160 @@
+// step_timing.hpp — per-step cost statistics and budget-overrun detection
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - A step that costs more than the fixed step itself leads to dropped
+//   substeps and, eventually, permanent catch-up; measure it directly
+// - min / avg / max / p99 over a sliding window of recent steps
+// - Overrun callback once a step crosses a fraction of its budget, as an
+//   early warning before the substep cap starts to bite; the runner calls
+//   it under its error policy, like the step function
+// - The runner hook is compiled only with ISHAP_ENABLE_STEP_TIMING=1
+//   (CMake option of the same name); otherwise attaching is not available
+//   and the step loop carries no timing code at all
+//
+// Usage
+//   ishap::timestep::StepTimingStats timing;
+//   timing.set_overrun_function([](auto cost, auto budget){ warn(cost, budget); });
+//   runner.set_step_timing(&timing);
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#ifndef ISHAP_ENABLE_STEP_TIMING
+#define ISHAP_ENABLE_STEP_TIMING 0
+#endif
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_step_timing_window                = 128;
+    inline constexpr double
+        k_default_step_budget_fraction      = 0.8;
+
+/**
+* @brief Sliding-window statistics of fixed step execution cost
+* @details Fed by the runner from the thread that ticks it; not thread-safe.
+*/
+class StepTimingStats {
+public:
+    using OnOverrunFunction = std::function<void(std::chrono::nanoseconds cost, std::chrono::nanoseconds budget)>;
+
+    StepTimingStats() = default;
+
+	/**
+	* @brief Constructs the statistics with an overrun callback and budget fraction.
+	* @param fn Called when a step's cost exceeds fraction * budget.
+	* @param fraction Fraction of the step duration that counts as the budget. Default is 0.8.
+	*/
+    explicit StepTimingStats(OnOverrunFunction fn, double fraction = k_default_step_budget_fraction)
+        : m_on_overrun_function(std::move(fn)) { set_budget_fraction(fraction); }
+
+	/**
+	* @brief Records the cost of one step and calls the overrun function if it exceeded the budget.
+	* @param cost The measured execution time of the step.
+	* @param step The fixed step duration the cost is compared against.
+	* @details Exceptions from the overrun function propagate; the runner uses record_cost() instead.
+	*/
+    void record(std::chrono::nanoseconds cost, std::chrono::nanoseconds step) {
+        if (record_cost(cost, step) && m_on_overrun_function) m_on_overrun_function(cost, budget(step));
+    }
+
+	/**
+	* @brief Records the cost of one step without calling the overrun function.
+	* @return True if the cost exceeded the budget (counted in overrun_count()).
+	*/
+    bool record_cost(std::chrono::nanoseconds cost, std::chrono::nanoseconds step) noexcept {
+        m_samples[m_next] = cost;
+        m_next = (m_next + 1) % k_step_timing_window;
+        if (m_count < k_step_timing_window) ++m_count;
+        ++m_total;
+
+        if (cost <= budget(step)) return false;
+        ++m_overruns;
+        return true;
+    }
+
+	/// @brief Get the budget for a step duration: step * budget_fraction().
+    [[nodiscard]] std::chrono::nanoseconds budget(std::chrono::nanoseconds step) const noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(step * m_budget_fraction);
+    }
+
+	/// @brief Clears all samples and counters.
+    void reset() noexcept { m_next = 0; m_count = 0; m_total = 0; m_overruns = 0; }
+
+	/**
+	* @brief Sets the fraction of the step duration used as the overrun threshold.
+	* @param f The fraction. Must be positive; values <= 0 are ignored.
+	*/
+    void set_budget_fraction(double f) noexcept { if (f > 0.0) m_budget_fraction = f; }
+	/// @brief Get the budget fraction.
+    [[nodiscard]] double budget_fraction() const noexcept { return m_budget_fraction; }
+
+	/// @brief Sets the function called when a step exceeds its budget.
+    void set_overrun_function(OnOverrunFunction fn) { m_on_overrun_function = std::move(fn); }
+	/// @brief Get the overrun function, for callers that invoke it themselves after record_cost().
+    [[nodiscard]] OnOverrunFunction& overrun_function() noexcept { return m_on_overrun_function; }
+
+	/// @brief Get the minimum step cost in the window.
+    [[nodiscard]] std::chrono::nanoseconds min() const noexcept {
+        if (m_count == 0) return std::chrono::nanoseconds(0);
+        return *std::min_element(m_samples.begin(), m_samples.begin() + static_cast<std::ptrdiff_t>(m_count));
+    }
+	/// @brief Get the maximum step cost in the window.
+    [[nodiscard]] std::chrono::nanoseconds max() const noexcept {
+        if (m_count == 0) return std::chrono::nanoseconds(0);
+        return *std::max_element(m_samples.begin(), m_samples.begin() + static_cast<std::ptrdiff_t>(m_count));
+    }
+	/// @brief Get the average step cost in the window.
+    [[nodiscard]] std::chrono::nanoseconds average() const noexcept {
+        if (m_count == 0) return std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds sum{0};
+        for (size_t i = 0; i < m_count; ++i) sum += m_samples[i];
+        return sum / static_cast<std::chrono::nanoseconds::rep>(m_count);
+    }
+	/// @brief Get the 99th percentile step cost in the window (nearest rank).
+    [[nodiscard]] std::chrono::nanoseconds p99() const noexcept { return percentile(0.99); }
+
+	/**
+	* @brief Get a percentile of the step cost in the window (nearest rank).
+	* @param q The quantile in [0, 1].
+	*/
+    [[nodiscard]] std::chrono::nanoseconds percentile(double q) const noexcept {
+        if (m_count == 0) return std::chrono::nanoseconds(0);
+        q = std::clamp(q, 0.0, 1.0);
+        std::array<std::chrono::nanoseconds, k_step_timing_window> sorted = m_samples;
+        const auto end = sorted.begin() + static_cast<std::ptrdiff_t>(m_count);
+        const auto rank = static_cast<std::ptrdiff_t>(q * static_cast<double>(m_count - 1) + 0.5);
+        std::nth_element(sorted.begin(), sorted.begin() + rank, end);
+        return sorted[static_cast<size_t>(rank)];
+    }
+
+	/// @brief Get the number of samples currently in the window.
+    [[nodiscard]] size_t sample_count() const noexcept { return m_count; }
+	/// @brief Get the number of steps recorded since the last reset.
+    [[nodiscard]] uint64_t total_count() const noexcept { return m_total; }
+	/// @brief Get the number of budget overruns since the last reset.
+    [[nodiscard]] uint64_t overrun_count() const noexcept { return m_overruns; }
+
+private:
+	/// @brief Ring of recent step costs
+    std::array<std::chrono::nanoseconds, k_step_timing_window> m_samples{};
+    size_t                          m_next{0};
+    size_t                          m_count{0};
+    uint64_t                        m_total{0};
+    uint64_t                        m_overruns{0};
+	/// @brief Fraction of the step duration considered the budget
+    double                          m_budget_fraction{k_default_step_budget_fraction};
+	/// @brief Optional overrun callback
+    OnOverrunFunction               m_on_overrun_function{};
+};
+
+} // namespace ishap::timestep
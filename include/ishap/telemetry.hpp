@@ -0,0 +1,254 @@
+// telemetry.hpp — per-tick telemetry records and a lock-free SPSC ring
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - The runner's last_*() accessors are overwritten every frame and are only
+//   safe on the thread that ticks; a ring keeps every tick's record
+// - Single producer (the sim thread) / single consumer (a metrics exporter),
+//   no locks, no allocations after construction
+// - When the consumer falls behind, new records are dropped and counted, so
+//   the sim thread never waits
+// - DeadlineHistogram counts how late each step started relative to its
+//   deadline (wait_for_next_step(), TimerFdDriver) in power-of-two buckets
+//   from 1us; it never drops, so it can run for a whole session and prove a
+//   thread tuning (thread_tuning.hpp) holds under production load
+//
+// Usage
+//   ishap::timestep::TelemetryRing ring{1024};
+//   runner.set_telemetry_ring(&ring);
+//   // monitoring thread
+//   ring.drain([](const ishap::timestep::TelemetryRecord& r){ export(r); });
+//
+//   ishap::timestep::DeadlineHistogram misses;
+//   runner.set_deadline_histogram(&misses);
+//   // monitoring thread
+//   log("p99 lateness %lld us", static_cast<long long>(misses.percentile(0.99).count() / 1000));
+//
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_cache_line_size                   = 64;
+    inline constexpr size_t
+        k_default_telemetry_capacity        = 1024;
+    inline constexpr size_t
+        k_deadline_histogram_buckets        = 20;   // [0, 1us), then [2^(i-1), 2^i) us; the last is open-ended
+
+/// @brief Telemetry of a single tick (one call to advance())
+struct TelemetryRecord {
+	/// @brief Time of the tick, as a duration since the runner clock's epoch
+    std::chrono::nanoseconds    timestamp           {0};
+	/// @brief Raw frame delta, before clamping and time scaling
+    std::chrono::nanoseconds    raw_delta           {0};
+	/// @brief Delta added to the accumulator, after the safety_max_delta clamp and time scaling
+    std::chrono::nanoseconds    clamped_delta       {0};
+	/// @brief Number of fixed steps executed
+    size_t                      steps               = 0;
+	/// @brief Number of due steps left unexecuted because safety_max_substeps was reached
+    size_t                      dropped_steps       = 0;
+	/// @brief Time discarded by the safety_max_accumulator_overflow trim
+    std::chrono::nanoseconds    trimmed             {0};
+	/// @brief Whole steps of debt carried to later ticks; dropped_steps minus this many were thrown away
+    size_t                      deferred_steps      = 0;
+};
+
+/**
+* @brief Lock-free single-producer / single-consumer ring of telemetry records
+* @details The producer is the thread that ticks the runner, the consumer any one other thread.
+*          Capacity is rounded up to a power of two and allocated once at construction.
+*/
+class TelemetryRing {
+public:
+	/**
+	* @brief Constructs a ring able to hold at least `capacity` records.
+	* @param capacity Requested capacity. If allocation fails the ring has capacity 0 and drops every record.
+	*/
+    explicit TelemetryRing(size_t capacity = k_default_telemetry_capacity) noexcept {
+        size_t c = 1;
+        while (c < capacity) c <<= 1;
+        m_records.reset(new (std::nothrow) TelemetryRecord[c]);
+        m_mask = m_records ? c - 1 : 0;
+        m_capacity = m_records ? c : 0;
+    }
+
+    TelemetryRing(const TelemetryRing&)            = delete;
+    TelemetryRing& operator=(const TelemetryRing&) = delete;
+
+	/**
+	* @brief Appends a record. Producer thread only.
+	* @return False if the ring was full and the record was dropped.
+	*/
+    bool try_push(const TelemetryRecord& record) noexcept {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail_cache >= m_capacity) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tail_cache >= m_capacity) {
+                m_overflow.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_records[head & m_mask] = record;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+	/**
+	* @brief Removes the oldest record. Consumer thread only.
+	* @param out Receives the record.
+	* @return False if the ring was empty.
+	*/
+    bool try_pop(TelemetryRecord& out) noexcept {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head_cache) {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail == m_head_cache) return false;
+        }
+        out = m_records[tail & m_mask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+	/**
+	* @brief Pops every record currently available and passes it to fn. Consumer thread only.
+	* @param fn Callable invoked as fn(const TelemetryRecord&).
+	* @return The number of records drained.
+	*/
+    template <class Fn>
+    size_t drain(Fn&& fn) {
+        size_t n = 0;
+        TelemetryRecord r;
+        while (try_pop(r)) { fn(static_cast<const TelemetryRecord&>(r)); ++n; }
+        return n;
+    }
+
+	/// @brief Get the number of slots in the ring.
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+	/// @brief Get an approximate count of records waiting to be consumed.
+    [[nodiscard]] size_t size_approx() const noexcept {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+	/// @brief Get the number of records dropped because the ring was full.
+    [[nodiscard]] uint64_t overflow_count() const noexcept { return m_overflow.load(std::memory_order_relaxed); }
+
+private:
+	/// @brief Record storage (power-of-two slots)
+    std::unique_ptr<TelemetryRecord[]>          m_records{};
+    size_t                                      m_mask{0};
+    size_t                                      m_capacity{0};
+
+	// --- Producer side ---
+    alignas(k_cache_line_size) std::atomic<size_t> m_head{0};
+    size_t                                      m_tail_cache{0};
+    std::atomic<uint64_t>                       m_overflow{0};
+
+	// --- Consumer side ---
+    alignas(k_cache_line_size) std::atomic<size_t> m_tail{0};
+    size_t                                      m_head_cache{0};
+};
+
+/**
+* @brief Histogram of step-start lateness (how far past its deadline each step began)
+* @details Bucket 0 counts starts less than 1us late (or early); bucket i > 0 counts [2^(i-1), 2^i) us, and the
+*          last bucket everything beyond. Written by the thread that ticks the runner, readable from any
+*          thread with relaxed atomics: totals may lag one another by a sample, but never tear.
+*/
+class DeadlineHistogram {
+public:
+    DeadlineHistogram() noexcept = default;
+    DeadlineHistogram(const DeadlineHistogram&)            = delete;
+    DeadlineHistogram& operator=(const DeadlineHistogram&) = delete;
+
+	/// @brief Records one step start. Producer thread only.
+    void record(std::chrono::nanoseconds lateness) noexcept {
+        const int64_t ns = lateness.count() < 0 ? 0 : lateness.count();
+        bump(m_buckets[bucket_for(ns)], 1);
+        bump(m_count, 1);
+        bump(m_total_ns, static_cast<uint64_t>(ns));
+        m_last_ns.store(ns, std::memory_order_relaxed);
+        if (ns > m_max_ns.load(std::memory_order_relaxed)) m_max_ns.store(ns, std::memory_order_relaxed);
+    }
+
+	/// @brief Get the number of recorded step starts.
+    [[nodiscard]] uint64_t count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+	/// @brief Get the count of one bucket (0 for an out-of-range index).
+    [[nodiscard]] uint64_t bucket(size_t i) const noexcept {
+        return i < k_deadline_histogram_buckets ? m_buckets[i].load(std::memory_order_relaxed) : 0;
+    }
+	/// @brief Get the lower bound of a bucket.
+    [[nodiscard]] static constexpr std::chrono::nanoseconds bucket_floor(size_t i) noexcept {
+        return std::chrono::nanoseconds(i == 0 ? 0 : int64_t{1000} << (i - 1));
+    }
+	/// @brief Get the lateness of the most recent step start.
+    [[nodiscard]] std::chrono::nanoseconds last() const noexcept { return std::chrono::nanoseconds(m_last_ns.load(std::memory_order_relaxed)); }
+	/// @brief Get the largest recorded lateness.
+    [[nodiscard]] std::chrono::nanoseconds max() const noexcept { return std::chrono::nanoseconds(m_max_ns.load(std::memory_order_relaxed)); }
+	/// @brief Get the mean lateness (0 before the first sample).
+    [[nodiscard]] std::chrono::nanoseconds mean() const noexcept {
+        const uint64_t n = count();
+        return std::chrono::nanoseconds(n == 0 ? 0 : static_cast<int64_t>(m_total_ns.load(std::memory_order_relaxed) / n));
+    }
+
+	/**
+	* @brief Get the number of step starts at least as late as a threshold, at bucket resolution.
+	* @param threshold Lateness counted as a miss; rounded down to a bucket floor.
+	*/
+    [[nodiscard]] uint64_t misses(std::chrono::nanoseconds threshold) const noexcept {
+        uint64_t n = 0;
+        for (size_t i = bucket_for(threshold.count() < 0 ? 0 : threshold.count()); i < k_deadline_histogram_buckets; ++i) n += bucket(i);
+        return n;
+    }
+
+	/**
+	* @brief Get an upper bound of a lateness percentile.
+	* @param q The quantile in [0, 1].
+	* @return The upper bound of the bucket holding the quantile; max() for the open-ended last bucket.
+	*/
+    [[nodiscard]] std::chrono::nanoseconds percentile(double q) const noexcept {
+        const uint64_t n = count();
+        if (n == 0) return std::chrono::nanoseconds(0);
+        const double target = (q < 0.0 ? 0.0 : (q > 1.0 ? 1.0 : q)) * static_cast<double>(n);
+        uint64_t seen = 0;
+        for (size_t i = 0; i + 1 < k_deadline_histogram_buckets; ++i) {
+            seen += bucket(i);
+            if (static_cast<double>(seen) >= target) return bucket_floor(i + 1);
+        }
+        return max();
+    }
+
+	/// @brief Clears every count. Call while no step is being recorded.
+    void reset() noexcept {
+        for (auto& b : m_buckets) b.store(0, std::memory_order_relaxed);
+        m_count.store(0, std::memory_order_relaxed);
+        m_total_ns.store(0, std::memory_order_relaxed);
+        m_last_ns.store(0, std::memory_order_relaxed);
+        m_max_ns.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    [[nodiscard]] static size_t bucket_for(int64_t ns) noexcept {
+        uint64_t us = static_cast<uint64_t>(ns) / 1000;
+        size_t i = 0;
+        while (us != 0 && i + 1 < k_deadline_histogram_buckets) { us >>= 1; ++i; }
+        return i;
+    }
+	/// @brief Single-writer increment: a load and a store, no read-modify-write
+    static void bump(std::atomic<uint64_t>& a, uint64_t n) noexcept {
+        a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t>                       m_buckets[k_deadline_histogram_buckets]{};
+    std::atomic<uint64_t>                       m_count{0};
+    std::atomic<uint64_t>                       m_total_ns{0};
+    std::atomic<int64_t>                        m_last_ns{0};
+    std::atomic<int64_t>                        m_max_ns{0};
+};
+
+} // namespace ishap::timestep
@@ -0,0 +1,208 @@
+// thread_tuning.hpp — CPU affinity, real-time priority and timer resolution for a dedicated sim thread
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - On a dedicated simulation thread, step-start jitter is dominated by the
+//   scheduler: the thread is preempted, migrated between cores or woken late
+//   by a coarse timer, not by the runner
+// - ThreadTuning names what to change: a CPU set to pin to, a real-time
+//   priority (SCHED_FIFO on Linux / POSIX, the MMCSS "Games" task on
+//   Windows) and, on Windows, a 1ms system timer resolution
+//   (timeBeginPeriod); other platforms already sleep at high resolution
+// - ScopedThreadTuning applies it to the calling thread and reverts every
+//   change it made on destruction; each setting that could not be applied
+//   (no CAP_SYS_NICE / RLIMIT_RTPRIO, no affinity API on macOS) is reported
+//   in applied() and error() instead of failing the others
+// - ThreadedRunner and PipelinedRunner take a ThreadTuning through
+//   set_thread_tuning() and apply it at the top of their worker thread;
+//   a DeadlineHistogram (telemetry.hpp) attached to the runner shows whether
+//   the tuning holds under load
+// - Windows links avrt and winmm (the CMake target does; MSVC also picks
+//   them up through #pragma comment)
+//
+// Usage
+//   ishap::timestep::ThreadTuning tuning;
+//   tuning.cpu_mask               = 1u << 3;   // core 3 only
+//   tuning.realtime_priority      = 50;
+//   tuning.raise_timer_resolution = true;
+//   sim.set_thread_tuning(tuning);       // ThreadedRunner, before start()
+//   // or, on a thread of your own
+//   ishap::timestep::ScopedThreadTuning scope{tuning};
+//   if (scope.applied() != scope.requested()) log("tuning incomplete, error %d", scope.error());
+//
+#pragma once
+
+#include <cstdint>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <avrt.h>
+#include <timeapi.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "avrt.lib")
+#pragma comment(lib, "winmm.lib")
+#endif
+#else
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ishap::timestep {
+
+/// @brief Scheduling changes for the thread that drives a runner; zero / false members are left alone
+struct ThreadTuning {
+	/// @brief CPUs the thread may run on, bit i for CPU i (the first 64 CPUs); 0 keeps the current affinity
+    uint64_t                    cpu_mask                = 0;
+	/// @brief SCHED_FIFO priority (clamped to the policy's range) on POSIX; any positive value selects the
+	///        MMCSS "Games" task at high priority on Windows; 0 keeps the current scheduling
+    int                         realtime_priority       = 0;
+	/// @brief Raise the system timer resolution to 1ms while applied (Windows only; ignored elsewhere)
+    bool                        raise_timer_resolution  = false;
+};
+
+/// @brief Bits of ScopedThreadTuning::requested() / applied()
+enum : uint32_t {
+    k_tuned_affinity            = 1u << 0,
+    k_tuned_priority            = 1u << 1,
+    k_tuned_timer_resolution    = 1u << 2,
+};
+
+/**
+* @brief Applies a ThreadTuning to the calling thread for the lifetime of the object
+* @details Construct and destroy it on the same thread. Settings are applied independently; a failed one
+*          leaves the thread as it was for that setting and records its error code.
+*/
+class ScopedThreadTuning {
+public:
+	/// @brief Applies nothing.
+    ScopedThreadTuning() noexcept = default;
+
+	/**
+	* @brief Applies the tuning to the calling thread.
+	* @param tuning The settings to apply.
+	*/
+    explicit ScopedThreadTuning(const ThreadTuning& tuning) noexcept {
+        if (tuning.cpu_mask != 0) {
+            m_requested |= k_tuned_affinity;
+            apply_affinity(tuning.cpu_mask);
+        }
+        if (tuning.realtime_priority > 0) {
+            m_requested |= k_tuned_priority;
+            apply_priority(tuning.realtime_priority);
+        }
+#if defined(_WIN32)
+        if (tuning.raise_timer_resolution) {
+            m_requested |= k_tuned_timer_resolution;
+            if (::timeBeginPeriod(1) == TIMERR_NOERROR) m_applied |= k_tuned_timer_resolution;
+            else fail(ERROR_INVALID_PARAMETER);
+        }
+#endif
+    }
+
+    ScopedThreadTuning(const ScopedThreadTuning&)            = delete;
+    ScopedThreadTuning& operator=(const ScopedThreadTuning&) = delete;
+
+	/// @brief Reverts every applied setting, in reverse order.
+    ~ScopedThreadTuning() {
+#if defined(_WIN32)
+        if (m_applied & k_tuned_timer_resolution) (void)::timeEndPeriod(1);
+        if (m_applied & k_tuned_priority) {
+            if (m_mmcss) (void)::AvRevertMmThreadCharacteristics(m_mmcss);
+            else         (void)::SetThreadPriority(::GetCurrentThread(), m_old_priority);
+        }
+        if (m_applied & k_tuned_affinity) (void)::SetThreadAffinityMask(::GetCurrentThread(), m_old_mask);
+#else
+        if (m_applied & k_tuned_priority) (void)::pthread_setschedparam(::pthread_self(), m_old_policy, &m_old_param);
+#if defined(__linux__)
+        if (m_applied & k_tuned_affinity) (void)::pthread_setaffinity_np(::pthread_self(), sizeof(m_old_set), &m_old_set);
+#endif
+#endif
+    }
+
+	/// @brief Get the k_tuned_* bits of the settings the tuning asked for.
+    [[nodiscard]] uint32_t requested() const noexcept { return m_requested; }
+	/// @brief Get the k_tuned_* bits of the settings actually in effect.
+    [[nodiscard]] uint32_t applied() const noexcept { return m_applied; }
+	/// @brief Get the error code (errno / GetLastError()) of the first setting that failed, or 0.
+    [[nodiscard]] int      error() const noexcept { return m_error; }
+
+private:
+    void fail(int code) noexcept { if (m_error == 0) m_error = code != 0 ? code : -1; }
+
+#if defined(_WIN32)
+    void apply_affinity(uint64_t mask) noexcept {
+        const DWORD_PTR m = static_cast<DWORD_PTR>(mask);
+        if (m == 0) { fail(ERROR_INVALID_PARAMETER); return; }   // only CPUs beyond the pointer width were selected
+        m_old_mask = ::SetThreadAffinityMask(::GetCurrentThread(), m);
+        if (m_old_mask != 0) m_applied |= k_tuned_affinity;
+        else fail(static_cast<int>(::GetLastError()));
+    }
+
+    void apply_priority(int) noexcept {
+        DWORD task = 0;
+        m_mmcss = ::AvSetMmThreadCharacteristicsW(L"Games", &task);
+        if (m_mmcss) {
+            (void)::AvSetMmThreadPriority(m_mmcss, AVRT_PRIORITY_HIGH);
+            m_applied |= k_tuned_priority;
+            return;
+        }
+        // MMCSS unavailable (service stopped, Server SKU): fall back to the highest normal-class priority
+        const int code = static_cast<int>(::GetLastError());
+        m_old_priority = ::GetThreadPriority(::GetCurrentThread());
+        if (::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) m_applied |= k_tuned_priority;
+        else fail(code);
+    }
+
+    DWORD_PTR                   m_old_mask{0};
+    HANDLE                      m_mmcss{nullptr};
+    int                         m_old_priority{THREAD_PRIORITY_NORMAL};
+#else
+    void apply_affinity(uint64_t mask) noexcept {
+#if defined(__linux__)
+        if (::pthread_getaffinity_np(::pthread_self(), sizeof(m_old_set), &m_old_set) != 0) { fail(errno); return; }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+            if (mask & (uint64_t{1} << cpu)) CPU_SET(cpu, &set);
+        }
+        const int rc = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+        if (rc == 0) m_applied |= k_tuned_affinity;
+        else fail(rc);
+#else
+        (void)mask;
+        fail(ENOTSUP);      // no thread affinity API (macOS has only affinity tags, which are hints)
+#endif
+    }
+
+    void apply_priority(int priority) noexcept {
+        int rc = ::pthread_getschedparam(::pthread_self(), &m_old_policy, &m_old_param);
+        if (rc != 0) { fail(rc); return; }
+        const int lo = ::sched_get_priority_min(SCHED_FIFO);
+        const int hi = ::sched_get_priority_max(SCHED_FIFO);
+        sched_param param{};
+        param.sched_priority = priority < lo ? lo : (priority > hi ? hi : priority);
+        rc = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param);
+        if (rc == 0) m_applied |= k_tuned_priority;
+        else fail(rc);      // EPERM without CAP_SYS_NICE or an RLIMIT_RTPRIO allowance
+    }
+
+#if defined(__linux__)
+    cpu_set_t                   m_old_set{};
+#endif
+    int                         m_old_policy{SCHED_OTHER};
+    sched_param                 m_old_param{};
+#endif
+
+    uint32_t                    m_requested{0};
+    uint32_t                    m_applied{0};
+    int                         m_error{0};
+};
+
+} // namespace ishap::timestep
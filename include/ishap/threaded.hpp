@@ -0,0 +1,295 @@
+// threaded.hpp — fixed-step simulation on its own thread, lock-free snapshots for rendering
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - With tick() and alpha() on the render thread, a slow frame delays the
+//   simulation and a slow step delays the frame
+// - ThreadedRunner drives a runner with wait_for_next_step() on a worker
+//   thread and steps a StateHistory in place
+// - After every tick that stepped, the latest two states and the wall time
+//   at which the current one became due are published through a
+//   TripleBuffer: the writer never waits for the reader and vice versa
+// - The render thread computes alpha from that shared timestamp and its own
+//   clock read, so it interpolates smoothly whatever rate it runs at
+// - set_thread_tuning() pins the worker to a core set and raises its
+//   priority as it starts (see thread_tuning.hpp)
+//
+// Usage
+//   ishap::timestep::ThreadedRunner<World> sim{
+//       [](const World& prev, World& next, std::chrono::nanoseconds dt){ simulate(prev, next, dt); },
+//       initial_world, {.step = ishap::timestep::k_step_120hz}
+//   };
+//   sim.start();
+//   for (;;) {                                  // render thread
+//       sim.acquire();
+//       render(sim.interpolate([](const World& p, const World& c, double a){ return blend(p, c, a); }));
+//   }
+//
+#pragma once
+
+#include "ishap.hpp"
+#include "state_history.hpp"
+#include "thread_tuning.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+
+namespace ishap::timestep {
+
+/**
+* @brief Lock-free single-producer / single-consumer triple buffer
+* @details The producer fills write_buffer() and publish()es it; the consumer update()s and reads
+*          read_buffer(). Neither side ever blocks; the consumer always sees the newest published value.
+*/
+template <class T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+	/// @brief Constructs the buffer with every slot set to the given value.
+    explicit TripleBuffer(const T& initial) { for (auto& s : m_slots) s.value = initial; }
+
+    TripleBuffer(const TripleBuffer&)            = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	/// @brief Get the slot the producer fills next. Producer thread only.
+    [[nodiscard]] T& write_buffer() noexcept { return m_slots[m_write].value; }
+
+	/// @brief Publishes the write buffer and takes over the previously shared slot. Producer thread only.
+    void publish() noexcept {
+        const uint8_t shared = m_shared.exchange(static_cast<uint8_t>(m_write | k_fresh), std::memory_order_acq_rel);
+        m_write = shared & k_index_mask;
+    }
+
+	/**
+	* @brief Takes the most recently published slot, if there is one the consumer has not seen. Consumer thread only.
+	* @return True if read_buffer() changed.
+	*/
+    bool update() noexcept {
+        if ((m_shared.load(std::memory_order_relaxed) & k_fresh) == 0) return false;
+        const uint8_t shared = m_shared.exchange(m_read, std::memory_order_acq_rel);
+        m_read = shared & k_index_mask;
+        return true;
+    }
+
+	/// @brief Get the slot last taken by update(). Consumer thread only.
+    [[nodiscard]] const T& read_buffer() const noexcept { return m_slots[m_read].value; }
+
+private:
+    static constexpr uint8_t k_index_mask   = 0x3;
+    static constexpr uint8_t k_fresh        = 0x4;
+
+	/// @brief A slot on its own cache line(s)
+    struct alignas(k_cache_line_size) Slot {
+        T                           value{};
+    };
+
+    std::array<Slot, 3>             m_slots{};
+	/// @brief Index of the shared slot, plus k_fresh when it holds a value the consumer has not taken
+    alignas(k_cache_line_size)
+    std::atomic<uint8_t>            m_shared{1};
+    alignas(k_cache_line_size)
+    uint8_t                         m_write{0};
+    alignas(k_cache_line_size)
+    uint8_t                         m_read{2};
+};
+
+/// @brief What the simulation thread publishes after a tick that stepped
+template <class T, class Clock = std::chrono::steady_clock>
+struct StepSnapshot {
+	/// @brief State one step before current
+    T                               previous{};
+	/// @brief State after the newest step
+    T                               current{};
+	/// @brief Wall time at which the newest step became due
+    typename Clock::time_point      timestamp{};
+	/// @brief Wall duration of one step (step / time scale); zero while paused or at time scale 0
+    std::chrono::nanoseconds        step_wall{0};
+	/// @brief Total steps run when the snapshot was taken
+    uint64_t                        step_count{0};
+};
+
+/**
+* @brief Runs a fixed-step simulation on a dedicated thread and hands snapshots to one render thread
+* @tparam T The simulation state. Stepped in place; copied twice per publishing tick.
+* @tparam StepFn Callable invoked as void(const T& previous, T& next, std::chrono::nanoseconds dt). Runs on
+*         the simulation thread; it must overwrite next completely (see StateHistory).
+* @tparam Clock Steady clock shared by both threads.
+* @details Configure through runner() before start() only; the runner is not thread-safe while running.
+*/
+template <class T,
+          class StepFn = std::function<void(const T&, T&, std::chrono::nanoseconds)>,
+          class Clock = std::chrono::steady_clock>
+class ThreadedRunner {
+    /// @brief Step callable handed to the runner; forwards to the user step through the history
+    struct Stepper {
+        ThreadedRunner* self{nullptr};
+        void operator()(std::chrono::nanoseconds dt) {
+            self->m_history.step([&](const T& prev, T& next){ self->m_step(prev, next, dt); });
+            ++self->m_step_count;
+        }
+    };
+
+public:
+    using clock_type = Clock;
+    using time_point = typename clock_type::time_point;
+    using snapshot_type = StepSnapshot<T, Clock>;
+    using runner_type = BasicFixedTimestepRunner<Stepper, NoErrorFunction, Clock>;
+
+	/**
+	* @brief Constructs a stopped threaded runner.
+	* @param fn The step function, invoked as fn(previous, next, dt).
+	* @param initial The initial state, published as both previous and current.
+	* @param config The runner configuration.
+	*/
+    ThreadedRunner(StepFn fn, const T& initial, Config config = {})
+        : m_step(std::move(fn)), m_history(initial), m_runner(Stepper{this}, std::move(config)) {
+        snapshot_type s;
+        s.previous = initial;
+        s.current = initial;
+        s.timestamp = clock_type::now();
+        m_snapshots.write_buffer() = s;
+        m_snapshots.publish();
+        (void)m_snapshots.update();
+    }
+
+    ThreadedRunner(const ThreadedRunner&)            = delete;
+    ThreadedRunner& operator=(const ThreadedRunner&) = delete;
+
+	/// @brief Stops and joins the simulation thread.
+    ~ThreadedRunner() { stop(); }
+
+	/**
+	* @brief Starts the simulation thread. Time starts now.
+	* @return False if it is already running or the thread could not be created.
+	*/
+    bool start() noexcept {
+        if (m_thread.joinable()) return false;
+        m_stop.store(false, std::memory_order_relaxed);
+        m_tuning_applied.store(0, std::memory_order_relaxed);
+        m_tuning_error.store(0, std::memory_order_relaxed);
+        m_runner.reset(true);
+#if ISHAP_HAS_EXCEPTIONS
+        try {
+            m_thread = std::thread([this]{ sim_main(); });
+        } catch (...) {
+            return false;
+        }
+#else
+        m_thread = std::thread([this]{ sim_main(); });
+#endif
+        return true;
+    }
+
+	/// @brief Requests the simulation thread to stop and joins it; returns within about one step.
+    void stop() noexcept {
+        m_stop.store(true, std::memory_order_release);
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+	/// @brief Returns whether the simulation thread is running.
+    [[nodiscard]] bool running() const noexcept { return m_thread.joinable(); }
+
+	/**
+	* @brief Takes the newest snapshot from the simulation thread. Render thread only.
+	* @return True if a newer snapshot than the previous one was taken.
+	*/
+    bool acquire() noexcept { return m_snapshots.update(); }
+
+	/// @brief Get the snapshot taken by the last acquire(). Render thread only.
+    [[nodiscard]] const snapshot_type& snapshot() const noexcept { return m_snapshots.read_buffer(); }
+
+	/**
+	* @brief Get the interpolation factor between snapshot().previous and snapshot().current at a point in time.
+	* @param now The render time, typically clock_type::now().
+	* @return (now - timestamp) / step_wall clamped to [0, 1]; 1 while paused.
+	* @details Rendering runs one step behind the simulation, which keeps alpha within the last published step.
+	*/
+    [[nodiscard]] double alpha(time_point now) const noexcept {
+        const snapshot_type& s = snapshot();
+        if (s.step_wall.count() <= 0) return 1.0;
+        const double a = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - s.timestamp).count())
+                       / static_cast<double>(s.step_wall.count());
+        return a < 0.0 ? 0.0 : (a > 1.0 ? 1.0 : a);
+    }
+	/// @brief Get the interpolation factor for the current time.
+    [[nodiscard]] double alpha() const noexcept { return alpha(clock_type::now()); }
+
+	/**
+	* @brief Interpolates the acquired snapshot with a user blend function at the current time.
+	* @param fn Callable invoked as fn(const T& previous, const T& current, double alpha).
+	* @return Whatever fn returns.
+	*/
+    template <class Fn>
+    decltype(auto) interpolate(Fn&& fn) const {
+        const snapshot_type& s = snapshot();
+        return std::forward<Fn>(fn)(s.previous, s.current, alpha());
+    }
+
+	/**
+	* @brief Sets the scheduling changes applied to the simulation thread as it starts. Call before start().
+	* @param tuning CPU affinity, real-time priority and timer resolution (see thread_tuning.hpp).
+	*/
+    void set_thread_tuning(const ThreadTuning& tuning) noexcept { m_tuning = tuning; }
+	/// @brief Get the tuning applied to the simulation thread.
+    [[nodiscard]] const ThreadTuning& thread_tuning() const noexcept { return m_tuning; }
+	/// @brief Get the k_tuned_* bits in effect on the simulation thread (0 until it has started).
+    [[nodiscard]] uint32_t thread_tuning_applied() const noexcept { return m_tuning_applied.load(std::memory_order_acquire); }
+	/// @brief Get the error code of the first tuning setting that failed on the simulation thread, or 0.
+    [[nodiscard]] int      thread_tuning_error() const noexcept { return m_tuning_error.load(std::memory_order_acquire); }
+
+	/// @brief Get the underlying runner, for configuration before start().
+    [[nodiscard]] runner_type& runner() noexcept { return m_runner; }
+
+private:
+    void sim_main() noexcept {
+        const ScopedThreadTuning tuning{m_tuning};
+        m_tuning_error.store(tuning.error(), std::memory_order_release);
+        m_tuning_applied.store(tuning.applied(), std::memory_order_release);
+        while (!m_stop.load(std::memory_order_acquire)) {
+            (void)m_runner.wait_for_next_step();
+            if (m_runner.last_steps() > 0) publish();
+        }
+    }
+
+	/// @brief Copies the two newest states into the triple buffer and timestamps them.
+    void publish() noexcept {
+        snapshot_type& s = m_snapshots.write_buffer();
+        s.previous      = m_history.previous();
+        s.current       = m_history.current();
+        s.step_count    = m_step_count;
+
+        // The newest step became due one step (in wall time) before the next one will
+        const time_point deadline = m_runner.next_step_deadline();
+        const double scale = m_runner.time_scale();
+        if (deadline == time_point::max() || scale <= 0.0) {
+            s.timestamp = clock_type::now();
+            s.step_wall = std::chrono::nanoseconds(0);
+        } else {
+            s.step_wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::duration<double, std::nano>(static_cast<double>(m_runner.step().count()) / scale));
+            s.timestamp = deadline - s.step_wall;
+        }
+        m_snapshots.publish();
+    }
+
+private:
+    StepFn                          m_step;
+    StateHistory<T, 2>              m_history;
+    uint64_t                        m_step_count{0};
+    runner_type                     m_runner;
+
+    TripleBuffer<snapshot_type>     m_snapshots{};
+    std::atomic<bool>               m_stop{false};
+    ThreadTuning                    m_tuning{};
+    std::atomic<uint32_t>           m_tuning_applied{0};
+    std::atomic<int>                m_tuning_error{0};
+    std::thread                     m_thread{};
+};
+
+} // namespace ishap::timestep
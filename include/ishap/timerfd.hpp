@@ -0,0 +1,159 @@
+// timerfd.hpp — Linux timerfd driver for running a runner inside an epoll / io_uring loop
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - An event-loop thread cannot block in wait_for_next_step(), and polling
+//   tick() between socket events either spins or steps late
+// - TimerFdDriver arms a CLOCK_MONOTONIC timerfd at next_step_deadline()
+//   (absolute, so re-arming never drifts) and hands out the fd for the
+//   caller's own epoll set or io_uring poll
+// - When the fd becomes readable, on_readable() ticks the runner and re-arms
+//   from the new accumulator; with steps still owed the deadline is already
+//   past and the timer fires again at once
+// - Wake-up latency is the kernel's hrtimer latency plus the thread's timer
+//   slack (50us by default, see prctl(PR_SET_TIMERSLACK)), well below the
+//   1ms-class granularity of sleep-based polling
+// - Linux only; the runner's clock must be std::chrono::steady_clock, which
+//   reads CLOCK_MONOTONIC there
+//
+// Usage
+//   ishap::timestep::FixedTimestepRunner runner{step, {.step = ishap::timestep::k_step_60hz}};
+//   ishap::timestep::TimerFdDriver driver{runner};
+//   epoll_event ev{.events = EPOLLIN, .data = {.fd = driver.fd()}};
+//   epoll_ctl(epfd, EPOLL_CTL_ADD, driver.fd(), &ev);
+//   for (;;) {
+//       const int n = epoll_wait(epfd, events, k_max_events, -1);
+//       for (int i = 0; i < n; ++i) {
+//           if (events[i].data.fd == driver.fd()) (void)driver.on_readable();
+//           else handle_socket(events[i]);
+//       }
+//   }
+//
+#pragma once
+
+#if !defined(__linux__)
+#error "ishap/timerfd.hpp requires Linux (timerfd_create)"
+#else
+
+#include "ishap.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <type_traits>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace ishap::timestep {
+
+/**
+* @brief Drives a runner from a timerfd armed at each next step deadline
+* @tparam Runner A BasicFixedTimestepRunner (or anything with tick(), alpha(), step() and
+*         next_step_deadline()) on std::chrono::steady_clock.
+* @details The driver owns the fd and closes it on destruction. Use it from the thread that ticks the
+*          runner; after pausing, resuming or changing the step outside on_readable(), call arm().
+*/
+template <class Runner>
+class TimerFdDriver {
+    static_assert(std::is_same_v<typename Runner::clock_type, std::chrono::steady_clock>,
+                  "TimerFdDriver arms CLOCK_MONOTONIC deadlines and needs a steady_clock runner");
+public:
+    using runner_type = Runner;
+    using clock_type = typename Runner::clock_type;
+    using time_point = typename clock_type::time_point;
+
+	/**
+	* @brief Creates the timerfd and arms it for the runner's next step.
+	* @param runner The runner to drive; must outlive the driver.
+	* @details On failure valid() is false and error_code() reports the cause; the driver then does nothing.
+	*/
+    explicit TimerFdDriver(Runner& runner) noexcept : m_runner(&runner) {
+        m_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (m_fd < 0) { m_errno = errno; return; }
+        (void)arm();
+    }
+
+    TimerFdDriver(const TimerFdDriver&)            = delete;
+    TimerFdDriver& operator=(const TimerFdDriver&) = delete;
+
+	/// @brief Closes the timerfd. Remove it from any epoll set first.
+    ~TimerFdDriver() { if (m_fd >= 0) ::close(m_fd); }
+
+	/// @brief Get the timerfd to register for readability (EPOLLIN / POLLIN); -1 if creation failed.
+    [[nodiscard]] int  fd() const noexcept { return m_fd; }
+	/// @brief Returns whether the timerfd was created.
+    [[nodiscard]] bool valid() const noexcept { return m_fd >= 0; }
+	/// @brief Get the errno of the last failed system call (0 if none).
+    [[nodiscard]] int  error_code() const noexcept { return m_errno; }
+
+	/**
+	* @brief Handles readiness of fd(): consumes the expiration, ticks the runner and re-arms.
+	* @return The interpolation alpha returned by tick(), or the current alpha if the timer had not expired.
+	* @details The lateness goes to the runner's deadline histogram only when the timer was armed at a real step
+	*          deadline, as in wait_for_next_step().
+	*/
+    double on_readable() noexcept(Runner::k_nothrow) {
+        uint64_t expirations = 0;
+        if (::read(m_fd, &expirations, sizeof(expirations)) != static_cast<ssize_t>(sizeof(expirations))) {
+            if (errno != EAGAIN) m_errno = errno;
+            return m_runner->alpha();
+        }
+        const time_point now = clock_type::now();
+        m_last_lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_deadline);
+        if (DeadlineHistogram* h = m_runner->deadline_histogram(); h && m_due) h->record(m_last_lateness);
+        const double a = m_runner->tick();
+        (void)arm();
+        return a;
+    }
+
+	/**
+	* @brief Arms the timer at the runner's next step deadline.
+	* @return False if timerfd_settime() failed (see error_code()).
+	* @details While paused (or at time scale 0) it re-checks one step duration from now, like wait_for_next_step().
+	*/
+    bool arm() noexcept {
+        if (m_fd < 0) return false;
+        time_point deadline = m_runner->next_step_deadline();
+        m_due = deadline != time_point::max();
+        if (!m_due) deadline = clock_type::now() + m_runner->step();
+        m_deadline = deadline;
+
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        if (ns <= 0) ns = 1; // an all-zero it_value disarms the timer
+        itimerspec spec{};
+        spec.it_value.tv_sec  = static_cast<time_t>(ns / 1'000'000'000);
+        spec.it_value.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+        if (::timerfd_settime(m_fd, TFD_TIMER_ABSTIME, &spec, nullptr) != 0) { m_errno = errno; return false; }
+        return true;
+    }
+
+	/// @brief Disarms the timer; fd() stays open and stops becoming readable until the next arm().
+    bool disarm() noexcept {
+        if (m_fd < 0) return false;
+        const itimerspec spec{};
+        if (::timerfd_settime(m_fd, 0, &spec, nullptr) != 0) { m_errno = errno; return false; }
+        return true;
+    }
+
+	/// @brief Get the deadline the timer is armed for.
+    [[nodiscard]] time_point deadline() const noexcept { return m_deadline; }
+	/// @brief Get how late the last on_readable() ran relative to its deadline (negative if early).
+    [[nodiscard]] std::chrono::nanoseconds last_lateness() const noexcept { return m_last_lateness; }
+	/// @brief Get the driven runner.
+    [[nodiscard]] Runner& runner() noexcept { return *m_runner; }
+
+private:
+    Runner*                         m_runner{nullptr};
+    int                             m_fd{-1};
+    int                             m_errno{0};
+    time_point                      m_deadline{};
+	/// @brief Whether m_deadline is a step deadline (false for the keep-alive re-check while paused)
+    bool                            m_due{false};
+    std::chrono::nanoseconds        m_last_lateness{0};
+};
+
+} // namespace ishap::timestep
+
+#endif
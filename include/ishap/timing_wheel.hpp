@@ -0,0 +1,279 @@
+// timing_wheel.hpp — hierarchical timing wheel of per-entity timers counted in fixed steps
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Entities that act every N steps (AI think, regen, despawn) are usually
+//   found by scanning every entity every step; the cost grows with the
+//   entity count, not with the work that is due
+// - TimingWheel keeps timers in 4 levels of 64 slots (Varghese & Lauck,
+//   as in the Linux kernel): level k holds timers due within 64^(k+1)
+//   steps, and a level's slot is cascaded into the level below when the
+//   step counter reaches it
+// - Insert and cancel are O(1) (intrusive lists linked by index); a step
+//   costs one slot's expiries plus, every 64 steps, a cascade
+// - Nodes live in a pool allocated once at construction; timers never
+//   allocate. Handles carry a generation, so a stale handle to a recycled
+//   node cannot cancel someone else's timer
+// - Delays beyond 64^4 steps are parked in the last slot and re-placed
+//   on each cascade until they come into range
+//
+// Usage
+//   ishap::timestep::TimingWheel wheel{4096};
+//   const uint64_t think = ishap::timestep::ticks_for(std::chrono::milliseconds(200), runner.step());
+//   entity.timer = wheel.schedule(think, entity.id, think);     // every 200ms
+//   runner.set_step_function([&](std::chrono::nanoseconds dt){
+//       wheel.advance([&](ishap::timestep::TimerHandle, uint64_t id){ think_about(id); });
+//       simulate(dt);
+//   });
+//
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_timing_wheel_levels               = 4;
+    inline constexpr size_t
+        k_timing_wheel_slot_bits            = 6;    // 64 slots per level
+    inline constexpr size_t
+        k_default_timing_wheel_capacity     = 1024;
+
+/// @brief Identifies a scheduled timer; stale once the timer fired (one-shot) or was cancelled
+struct TimerHandle {
+    uint32_t                    index               = UINT32_MAX;
+    uint32_t                    generation          = 0;
+
+	/// @brief Returns whether the handle was issued by schedule() (it may be stale by now).
+    [[nodiscard]] constexpr bool valid() const noexcept { return index != UINT32_MAX; }
+    [[nodiscard]] friend constexpr bool operator==(TimerHandle a, TimerHandle b) noexcept {
+        return a.index == b.index && a.generation == b.generation;
+    }
+    [[nodiscard]] friend constexpr bool operator!=(TimerHandle a, TimerHandle b) noexcept { return !(a == b); }
+};
+
+/**
+* @brief Converts a duration to a whole number of fixed steps, rounding up (at least 1).
+* @param interval The duration.
+* @param step The fixed step.
+*/
+[[nodiscard]] constexpr uint64_t ticks_for(std::chrono::nanoseconds interval, std::chrono::nanoseconds step) noexcept {
+    if (step.count() <= 0 || interval.count() <= step.count()) return 1;
+    return static_cast<uint64_t>((interval.count() + step.count() - 1) / step.count());
+}
+
+/**
+* @brief Hierarchical timing wheel of one-shot and periodic timers, advanced once per fixed step
+* @details Each timer carries a 64-bit user value (an entity id, an index, a pointer) passed to the expiry
+*          callback. Not thread-safe; advance it from the step function.
+*/
+class TimingWheel {
+public:
+	/**
+	* @brief Constructs a wheel with a fixed node pool.
+	* @param capacity Maximum number of pending timers. If allocation fails the capacity is 0.
+	* @param start_tick The step count the wheel starts at (e.g. runner.step_index()).
+	*/
+    explicit TimingWheel(size_t capacity = k_default_timing_wheel_capacity, uint64_t start_tick = 0) noexcept
+        : m_now(start_tick) {
+        if (capacity >= k_nil) capacity = k_nil - 1;
+        m_nodes.reset(new (std::nothrow) Node[capacity]);
+        m_capacity = m_nodes ? static_cast<uint32_t>(capacity) : 0;
+        clear();
+    }
+
+    TimingWheel(const TimingWheel&)            = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+	/**
+	* @brief Schedules a timer.
+	* @param delay Steps from now until the first expiry; 0 is treated as 1 (the next advance()).
+	* @param data User value passed to the expiry callback.
+	* @param interval Steps between later expiries; 0 for a one-shot timer.
+	* @return The timer's handle, or an invalid handle if the pool is exhausted.
+	*/
+    TimerHandle schedule(uint64_t delay, uint64_t data = 0, uint64_t interval = 0) noexcept {
+        if (m_free == k_nil) return TimerHandle{};
+        const uint32_t i = m_free;
+        Node& n = m_nodes[i];
+        m_free = n.next;
+        n.expiry    = m_now + (delay == 0 ? 1 : delay);
+        n.interval  = interval;
+        n.data      = data;
+        link(i);
+        ++m_size;
+        return TimerHandle{i, n.generation};
+    }
+
+	/**
+	* @brief Cancels a pending timer. Safe to call from the expiry callback, for any timer.
+	* @return False if the handle is stale (already fired, cancelled or never issued).
+	*/
+    bool cancel(TimerHandle h) noexcept {
+        if (!pending(h)) return false;
+        unlink(h.index);
+        release(h.index);
+        return true;
+    }
+
+	/// @brief Returns whether the timer is still pending.
+    [[nodiscard]] bool pending(TimerHandle h) const noexcept {
+        return h.index < m_capacity && m_nodes[h.index].generation == h.generation && m_nodes[h.index].slot != k_no_slot;
+    }
+
+	/// @brief Get the step at which a pending timer fires next (0 if the handle is stale).
+    [[nodiscard]] uint64_t expiry(TimerHandle h) const noexcept { return pending(h) ? m_nodes[h.index].expiry : 0; }
+
+	/**
+	* @brief Advances the wheel by one step and fires the timers due at it.
+	* @param fn Callable invoked as fn(TimerHandle, uint64_t data) for every expiry. Periodic timers are re-armed
+	*        before the call, one-shot timers are released; it may schedule and cancel timers.
+	* @return The number of timers fired.
+	*/
+    template <class Fn>
+    size_t advance(Fn&& fn) {
+        ++m_now;
+        // Cascade: when a level's slot index wraps to 0, the next level's current slot comes into range
+        for (size_t level = 1; level < k_timing_wheel_levels; ++level) {
+            if (slot_index(m_now, level - 1) != 0) break;
+            cascade(level, slot_index(m_now, level));
+        }
+
+        size_t fired = 0;
+        uint32_t& head = m_heads[slot_id(0, slot_index(m_now, 0))];
+        while (head != k_nil) {
+            const uint32_t i = head;
+            Node& n = m_nodes[i];
+            unlink(i);
+            const TimerHandle h{i, n.generation};
+            const uint64_t data = n.data;
+            if (n.interval > 0) {
+                n.expiry += n.interval;
+                link(i);
+            } else {
+                release(i);
+            }
+            fn(h, data);
+            ++fired;
+        }
+        return fired;
+    }
+
+	/**
+	* @brief Advances the wheel to a step count, firing everything due on the way.
+	* @param tick The target step count; nothing happens if it is not after now().
+	* @param fn As for advance().
+	* @return The number of timers fired.
+	*/
+    template <class Fn>
+    size_t advance_to(uint64_t tick, Fn&& fn) {
+        size_t fired = 0;
+        while (m_now < tick) fired += advance(fn);
+        return fired;
+    }
+
+	/// @brief Cancels every timer. The step count is kept.
+    void clear() noexcept {
+        m_heads.fill(k_nil);
+        m_free = m_capacity > 0 ? 0 : k_nil;
+        for (uint32_t i = 0; i < m_capacity; ++i) {
+            if (m_nodes[i].slot != k_no_slot) ++m_nodes[i].generation;
+            m_nodes[i].slot = k_no_slot;
+            m_nodes[i].next = i + 1 < m_capacity ? i + 1 : k_nil;
+        }
+        m_size = 0;
+    }
+
+	/// @brief Get the step count: the number of advance() calls plus the start tick.
+    [[nodiscard]] uint64_t now() const noexcept { return m_now; }
+	/// @brief Get the number of pending timers.
+    [[nodiscard]] size_t   size() const noexcept { return m_size; }
+	/// @brief Returns whether no timer is pending.
+    [[nodiscard]] bool     empty() const noexcept { return m_size == 0; }
+	/// @brief Get the maximum number of pending timers.
+    [[nodiscard]] size_t   capacity() const noexcept { return m_capacity; }
+
+private:
+    static constexpr uint32_t   k_nil           = UINT32_MAX;
+    static constexpr uint16_t   k_no_slot       = UINT16_MAX;
+    static constexpr size_t     k_slots         = size_t{1} << k_timing_wheel_slot_bits;
+    static constexpr uint64_t   k_slot_mask     = k_slots - 1;
+	/// @brief Steps covered by all levels; later expiries are parked in the last slot
+    static constexpr uint64_t   k_range         = uint64_t{1} << (k_timing_wheel_slot_bits * k_timing_wheel_levels);
+
+    struct Node {
+        uint64_t                expiry{0};
+        uint64_t                interval{0};
+        uint64_t                data{0};
+        uint32_t                prev{k_nil};
+        uint32_t                next{k_nil};
+        uint32_t                generation{0};
+        uint16_t                slot{k_no_slot};
+    };
+
+    [[nodiscard]] static constexpr size_t slot_index(uint64_t tick, size_t level) noexcept {
+        return static_cast<size_t>((tick >> (level * k_timing_wheel_slot_bits)) & k_slot_mask);
+    }
+    [[nodiscard]] static constexpr size_t slot_id(size_t level, size_t index) noexcept { return level * k_slots + index; }
+
+	/// @brief Puts a node at the head of the slot its expiry falls in, relative to now.
+    void link(uint32_t i) noexcept {
+        Node& n = m_nodes[i];
+        const uint64_t delta = n.expiry - m_now;
+        size_t id = slot_id(k_timing_wheel_levels - 1, slot_index(m_now + k_range - 1, k_timing_wheel_levels - 1));
+        for (size_t level = 0; level < k_timing_wheel_levels; ++level) {
+            if (delta < (uint64_t{1} << ((level + 1) * k_timing_wheel_slot_bits))) {
+                id = slot_id(level, slot_index(n.expiry, level));
+                break;
+            }
+        }
+        n.slot = static_cast<uint16_t>(id);
+        n.prev = k_nil;
+        n.next = m_heads[id];
+        if (n.next != k_nil) m_nodes[n.next].prev = i;
+        m_heads[id] = i;
+    }
+
+    void unlink(uint32_t i) noexcept {
+        Node& n = m_nodes[i];
+        if (n.prev != k_nil) m_nodes[n.prev].next = n.next;
+        else                 m_heads[n.slot] = n.next;
+        if (n.next != k_nil) m_nodes[n.next].prev = n.prev;
+        n.slot = k_no_slot;
+    }
+
+	/// @brief Returns an unlinked node to the pool, staling its handles.
+    void release(uint32_t i) noexcept {
+        Node& n = m_nodes[i];
+        ++n.generation;
+        n.next = m_free;
+        m_free = i;
+        --m_size;
+    }
+
+	/// @brief Re-places every node of a slot relative to now (into lower levels, or parked again).
+    void cascade(size_t level, size_t index) noexcept {
+        uint32_t i = m_heads[slot_id(level, index)];
+        m_heads[slot_id(level, index)] = k_nil;
+        while (i != k_nil) {
+            const uint32_t next = m_nodes[i].next;
+            link(i);
+            i = next;
+        }
+    }
+
+private:
+    std::unique_ptr<Node[]>                                     m_nodes{};
+    uint32_t                                                    m_capacity{0};
+    uint32_t                                                    m_free{k_nil};
+    size_t                                                      m_size{0};
+    uint64_t                                                    m_now{0};
+    std::array<uint32_t, k_timing_wheel_levels * k_slots>       m_heads{};
+};
+
+} // namespace ishap::timestep
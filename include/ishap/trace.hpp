@@ -0,0 +1,266 @@
+// trace.hpp — compile-time-optional timeline tracing, flushed as Chrome trace JSON
+// SPDX-License-Identifier: MIT
+//
+// Rationale
+// - Telemetry records what a tick did; a timeline shows when it ran, how
+//   long each substep took and where the accumulator was trimmed
+// - ISHAP_TRACE_* macros write begin / end, counter and instant events into
+//   a per-thread buffer: one relaxed load, one store and one release store
+//   per event, no locks; a full buffer drops events and counts them
+// - Buffers register themselves on a lock-free list the first time a thread
+//   traces and are never freed, so events of exited threads stay flushable
+// - write_chrome_trace() drains every buffer into the Trace Event JSON
+//   format, which chrome://tracing and ui.perfetto.dev both load; drain_trace()
+//   hands out raw events for other sinks
+// - Compiled only with ISHAP_ENABLE_TRACING=1 (CMake option of the same
+//   name); otherwise every macro expands to nothing and the runner carries
+//   no tracing code
+//
+// Usage
+//   ISHAP_TRACE_SCOPE("game.frame");
+//   ISHAP_TRACE_COUNTER("game.entities", world.size());
+//   // at shutdown or on demand, from any one thread
+//   std::FILE* f = std::fopen("ishap.trace.json", "w");
+//   ishap::timestep::write_chrome_trace(f);
+//   std::fclose(f);
+//
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+
+#include "telemetry.hpp"
+
+#ifndef ISHAP_ENABLE_TRACING
+#define ISHAP_ENABLE_TRACING 0
+#endif
+
+namespace ishap::timestep {
+
+    inline constexpr size_t
+        k_trace_buffer_events               = 8192;     // per thread, power of two
+
+/// @brief Kind of a trace event, as its Trace Event Format phase character
+enum class TracePhase : char {
+    begin       = 'B',  ///< Start of a duration
+    end         = 'E',  ///< End of the innermost open duration
+    counter     = 'C',  ///< Sampled value
+    instant     = 'i',  ///< Point in time
+};
+
+/// @brief One recorded trace event
+struct TraceEvent {
+	/// @brief Event name; must have static storage duration (a string literal)
+    const char*                 name                = nullptr;
+	/// @brief steady_clock time of the event
+    std::chrono::nanoseconds    timestamp           {0};
+	/// @brief Counter value (counter events only)
+    int64_t                     value               = 0;
+    TracePhase                  phase               = TracePhase::instant;
+};
+
+/**
+* @brief Lock-free single-producer / single-consumer event buffer of one thread
+* @details The producer is the owning thread, the consumer whichever thread flushes. Created by the
+*          tracing functions on first use; not meant to be constructed directly.
+*/
+class TraceBuffer {
+public:
+    static_assert((k_trace_buffer_events & (k_trace_buffer_events - 1)) == 0, "k_trace_buffer_events must be a power of two");
+
+    explicit TraceBuffer(uint32_t thread_id) noexcept : m_thread_id(thread_id) {}
+
+    TraceBuffer(const TraceBuffer&)            = delete;
+    TraceBuffer& operator=(const TraceBuffer&) = delete;
+
+	/// @brief Appends an event, dropping it when the buffer is full. Owning thread only.
+    void push(const char* name, TracePhase phase, int64_t value = 0) noexcept {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail_cache >= k_trace_buffer_events) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tail_cache >= k_trace_buffer_events) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        TraceEvent& e = m_events[head & (k_trace_buffer_events - 1)];
+        e.name      = name;
+        e.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+        e.value     = value;
+        e.phase     = phase;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+	/**
+	* @brief Passes every event currently buffered to fn and frees their slots. Consumer thread only.
+	* @param fn Callable invoked as fn(const TraceEvent&, uint32_t thread_id).
+	* @return The number of events drained.
+	*/
+    template <class Fn>
+    size_t drain(Fn&& fn) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        for (size_t i = tail; i != head; ++i) {
+            fn(static_cast<const TraceEvent&>(m_events[i & (k_trace_buffer_events - 1)]), m_thread_id);
+        }
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+	/// @brief Get the small sequential id of the owning thread (1 for the first thread that traced).
+    [[nodiscard]] uint32_t thread_id() const noexcept { return m_thread_id; }
+	/// @brief Get the number of events dropped because the buffer was full.
+    [[nodiscard]] uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+	/// @brief Get the next buffer on the registry list.
+    [[nodiscard]] TraceBuffer* next() const noexcept { return m_next; }
+
+private:
+    friend TraceBuffer* this_thread_trace_buffer() noexcept;
+
+    TraceEvent                                  m_events[k_trace_buffer_events]{};
+    uint32_t                                    m_thread_id{0};
+    TraceBuffer*                                m_next{nullptr};
+
+	// --- Producer side ---
+    alignas(k_cache_line_size) std::atomic<size_t> m_head{0};
+    size_t                                      m_tail_cache{0};
+    std::atomic<uint64_t>                       m_dropped{0};
+
+	// --- Consumer side ---
+    alignas(k_cache_line_size) std::atomic<size_t> m_tail{0};
+};
+
+namespace detail {
+
+    /// @brief Head of the list of every thread's buffer, newest first
+    inline std::atomic<TraceBuffer*>    g_trace_buffers{nullptr};
+    /// @brief Last thread id handed out
+    inline std::atomic<uint32_t>        g_trace_thread_ids{0};
+
+    /// @brief Writes a string as a JSON string literal.
+    inline void write_json_string(std::FILE* out, const char* s) {
+        std::fputc('"', out);
+        for (; s && *s; ++s) {
+            const unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\')  { std::fputc('\\', out); std::fputc(c, out); }
+            else if (c < 0x20)          { std::fprintf(out, "\\u%04x", c); }
+            else                        { std::fputc(c, out); }
+        }
+        std::fputc('"', out);
+    }
+
+} // namespace detail
+
+/**
+* @brief Get the calling thread's trace buffer, creating and registering it on first use.
+* @return The buffer, or nullptr if it could not be allocated (events are then discarded).
+*/
+inline TraceBuffer* this_thread_trace_buffer() noexcept {
+    thread_local TraceBuffer* buffer = [] {
+        const uint32_t id = detail::g_trace_thread_ids.fetch_add(1, std::memory_order_relaxed) + 1;
+        TraceBuffer* b = new (std::nothrow) TraceBuffer(id);
+        if (!b) return b;
+        b->m_next = detail::g_trace_buffers.load(std::memory_order_relaxed);
+        while (!detail::g_trace_buffers.compare_exchange_weak(b->m_next, b, std::memory_order_release,
+                                                              std::memory_order_relaxed)) {}
+        return b;
+    }();
+    return buffer;
+}
+
+	/// @brief Records the start of a duration on the calling thread.
+inline void trace_begin(const char* name) noexcept {
+    if (TraceBuffer* b = this_thread_trace_buffer()) b->push(name, TracePhase::begin);
+}
+	/// @brief Records the end of the calling thread's innermost open duration.
+inline void trace_end(const char* name) noexcept {
+    if (TraceBuffer* b = this_thread_trace_buffer()) b->push(name, TracePhase::end);
+}
+	/// @brief Records a counter sample on the calling thread.
+inline void trace_counter(const char* name, int64_t value) noexcept {
+    if (TraceBuffer* b = this_thread_trace_buffer()) b->push(name, TracePhase::counter, value);
+}
+	/// @brief Records a point in time on the calling thread.
+inline void trace_instant(const char* name) noexcept {
+    if (TraceBuffer* b = this_thread_trace_buffer()) b->push(name, TracePhase::instant);
+}
+
+/// @brief Begins a duration on construction and ends it on destruction
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) noexcept : m_name(name) { trace_begin(m_name); }
+    ~TraceScope() { trace_end(m_name); }
+
+    TraceScope(const TraceScope&)            = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char*                     m_name;
+};
+
+/**
+* @brief Drains the buffers of every thread that traced. Call from one thread at a time.
+* @param fn Callable invoked as fn(const TraceEvent&, uint32_t thread_id); events of one thread arrive in order.
+* @return The number of events drained.
+*/
+template <class Fn>
+size_t drain_trace(Fn&& fn) {
+    size_t n = 0;
+    for (TraceBuffer* b = detail::g_trace_buffers.load(std::memory_order_acquire); b; b = b->next()) n += b->drain(fn);
+    return n;
+}
+
+/// @brief Get the total number of events dropped by full buffers, over all threads.
+[[nodiscard]] inline uint64_t trace_dropped_events() noexcept {
+    uint64_t n = 0;
+    for (TraceBuffer* b = detail::g_trace_buffers.load(std::memory_order_acquire); b; b = b->next()) n += b->dropped();
+    return n;
+}
+
+/**
+* @brief Drains every buffer into a complete Trace Event Format JSON document.
+* @param out An open file; left open.
+* @return The number of events written. Each call writes a separate document of the events since the last drain.
+*/
+inline size_t write_chrome_trace(std::FILE* out) {
+    if (!out) return 0;
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", out);
+    bool first = true;
+    const size_t n = drain_trace([&](const TraceEvent& e, uint32_t tid) {
+        std::fputs(first ? "\n" : ",\n", out);
+        first = false;
+        std::fputs("{\"name\":", out);
+        detail::write_json_string(out, e.name);
+        std::fprintf(out, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+                     static_cast<char>(e.phase), static_cast<double>(e.timestamp.count()) / 1e3, tid);
+        if (e.phase == TracePhase::counter) std::fprintf(out, ",\"args\":{\"value\":%lld}", static_cast<long long>(e.value));
+        else if (e.phase == TracePhase::instant) std::fputs(",\"s\":\"t\"", out);
+        std::fputc('}', out);
+    });
+    std::fputs("\n]}\n", out);
+    return n;
+}
+
+} // namespace ishap::timestep
+
+#define ISHAP_TRACE_CONCAT_IMPL(a, b) a##b
+#define ISHAP_TRACE_CONCAT(a, b) ISHAP_TRACE_CONCAT_IMPL(a, b)
+
+#if ISHAP_ENABLE_TRACING
+#define ISHAP_TRACE_BEGIN(name)             ::ishap::timestep::trace_begin(name)
+#define ISHAP_TRACE_END(name)               ::ishap::timestep::trace_end(name)
+#define ISHAP_TRACE_SCOPE(name)             const ::ishap::timestep::TraceScope ISHAP_TRACE_CONCAT(ishap_trace_scope_, __LINE__){name}
+#define ISHAP_TRACE_COUNTER(name, value)    ::ishap::timestep::trace_counter(name, static_cast<int64_t>(value))
+#define ISHAP_TRACE_INSTANT(name)           ::ishap::timestep::trace_instant(name)
+#else
+#define ISHAP_TRACE_BEGIN(name)             ((void)0)
+#define ISHAP_TRACE_END(name)               ((void)0)
+#define ISHAP_TRACE_SCOPE(name)             ((void)0)
+#define ISHAP_TRACE_COUNTER(name, value)    ((void)0)
+#define ISHAP_TRACE_INSTANT(name)           ((void)0)
+#endif